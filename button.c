@@ -0,0 +1,91 @@
+//debounced button handling, sampled from the periodic timer tick
+
+//the functions
+
+#include "button.h"
+
+#include <avr/io.h>
+
+//event queue, only button_tick() writes to head and
+//only button_get_event() writes to tail
+static volatile uint8_t button_queue[BUTTON_QUEUE_LEN];
+static volatile uint8_t button_head=0;
+static volatile uint8_t button_tail=0;
+
+static uint8_t integrator=0; //counts up while pressed, down while released
+static uint8_t pressed=0; //debounced state
+static uint8_t held_ticks=0; //how long it has been pressed or released
+static uint8_t short_pending=0; //a short press waiting to see if
+                                //it becomes a double press
+
+static void button_put_event(uint8_t ev);
+
+void init_button(void){
+    //setup for input
+    BUTTON_DDR &= ~(1<<BUTTON_BIT);
+    //enable pullup
+    BUTTON_PORT |= (1<<BUTTON_BIT);
+}
+
+static void button_put_event(uint8_t ev){
+    uint8_t next = (button_head + 1) & (BUTTON_QUEUE_LEN - 1);
+    if(next != button_tail){ //drop the event if the queue is full
+        button_queue[button_head] = ev;
+        button_head = next;
+    }
+}
+
+void button_tick(void){
+    //integrate the raw pin state, the button pulls the pin low
+    if(bit_is_clear(BUTTON_PIN, BUTTON_BIT)){
+        if(integrator < BUTTON_INTEGRATOR_MAX){
+            integrator++;
+        }
+    } else if(integrator > 0){
+        integrator--;
+    }
+    
+    if(held_ticks < 0xff){
+        held_ticks++;
+    }
+    
+    if(!pressed && (integrator == BUTTON_INTEGRATOR_MAX)){
+        //just got pressed
+        pressed=1;
+        if(short_pending){
+            //second press soon after the first one
+            short_pending=0;
+            button_put_event(BUTTON_EV_DOUBLE);
+            held_ticks=BUTTON_LONG_TICKS; //so the release is ignored
+        } else {
+            held_ticks=0;
+        }
+    }
+    else if(pressed && (integrator == 0)){
+        //just got released
+        pressed=0;
+        if(held_ticks < BUTTON_LONG_TICKS){
+            short_pending=1;
+        }
+        held_ticks=0;
+    }
+    else if(pressed){
+        if(held_ticks == BUTTON_LONG_TICKS){
+            button_put_event(BUTTON_EV_LONG);
+        }
+    }
+    else if(short_pending && (held_ticks >= BUTTON_DOUBLE_TICKS)){
+        //no second press came, so it was a short one
+        short_pending=0;
+        button_put_event(BUTTON_EV_SHORT);
+    }
+}
+
+uint8_t button_get_event(void){
+    uint8_t ev = BUTTON_EV_NONE;
+    if(button_tail != button_head){
+        ev = button_queue[button_tail];
+        button_tail = (button_tail + 1) & (BUTTON_QUEUE_LEN - 1);
+    }
+    return ev;
+}
@@ -0,0 +1,40 @@
+//debounced button handling, sampled from the periodic timer tick
+
+
+//header file with button stuff
+
+#ifndef BUTTON_H
+#define BUTTON_H
+
+#include <stdint.h>
+
+#define BUTTON_BIT 6 //bit number on BUTTON_PORT to be used for button
+#define BUTTON_DDR DDRB //DDRx for BUTTON_PORT
+#define BUTTON_PORT PORTB //PORTx that the button is connected to
+#define BUTTON_PIN PINB //PINx for the port the button is connected to
+
+//all of these are counted in calls to button_tick(),
+//which is every timer1 overflow (8.192ms at 8MHz)
+#define BUTTON_INTEGRATOR_MAX 4 //samples the pin has to agree for before
+                                //the debounced state changes (~33ms)
+#define BUTTON_LONG_TICKS 100 //held this long is a long press (~0.8s)
+#define BUTTON_DOUBLE_TICKS 40 //second press within this long after
+                                //a release makes a double press (~0.33s)
+
+#define BUTTON_QUEUE_LEN 4 //must be a power of 2
+
+//events handed out by button_get_event()
+#define BUTTON_EV_NONE 0
+#define BUTTON_EV_SHORT 1
+#define BUTTON_EV_LONG 2
+#define BUTTON_EV_DOUBLE 3
+
+void init_button(void);
+
+//samples and debounces the button, call this from the timer ISR
+void button_tick(void);
+
+//returns the oldest queued event, or BUTTON_EV_NONE
+uint8_t button_get_event(void);
+
+#endif
@@ -0,0 +1,111 @@
+//the display backends, only the one picked with DISPLAY_BACKEND gets built.
+//these only call the drivers, so they build on a PC against the stand-ins
+//in host/ too.
+
+#include "display.h"
+
+#if DISPLAY_BACKEND == DISPLAY_HT1632C
+
+#include "ht1632c.h"
+
+//column x is at address x*2, two nibbles each
+
+void display_init(void){
+    ht1632c_init();
+}
+
+void display_resume(void){
+    ht1632c_init_pins();
+}
+
+void display_push(const uint8_t *cols, uint32_t mask){
+    uint8_t i=32;
+    while(i--)
+    {
+        if(mask & ((uint32_t)1<<31)){
+            ht1632c_data8((i*2),cols[i]);
+        }
+        mask <<= 1;
+    }
+}
+
+void display_push_all(const uint8_t *cols){
+    //one successive-address write, rather than 32 with their own addresses
+    ht1632c_write_burst(0, cols, 32);
+}
+
+void display_bright(uint8_t level){
+    ht1632c_bright(level);
+}
+
+#elif DISPLAY_BACKEND == DISPLAY_MAX7219
+
+#include "max7219.h"
+
+//column x is digit register x%8 of module x/8, so digit d of every module
+//goes in one load, columns d, d+8, d+16 and d+24
+
+void display_init(void){
+    max7219_init();
+}
+
+void display_resume(void){
+    max7219_init_pins();
+}
+
+void display_push(const uint8_t *cols, uint32_t mask){
+    uint8_t d;
+    for(d=0; d<8; d++){
+        if(mask & ((uint32_t)0x01010101 << d)){
+            max7219_digit(d, cols + d);
+        }
+    }
+}
+
+void display_push_all(const uint8_t *cols){
+    display_push(cols, 0xffffffff);
+}
+
+void display_bright(uint8_t level){
+    max7219_all(MAX7219_INTENSITY, level);
+}
+
+#elif DISPLAY_BACKEND == DISPLAY_HC595
+
+#include "hc595.h"
+
+//nothing gets sent until display_refresh(), which goes through the
+//columns it was last given each time
+static const uint8_t *shown_cols=0;
+static uint8_t shown_level=7;
+
+void display_init(void){
+    hc595_init();
+}
+
+void display_resume(void){
+    hc595_init();
+}
+
+void display_push(const uint8_t *cols, uint32_t mask){
+    (void)mask;
+    shown_cols = cols;
+}
+
+void display_push_all(const uint8_t *cols){
+    shown_cols = cols;
+}
+
+void display_bright(uint8_t level){
+    shown_level = level;
+}
+
+void display_refresh(void){
+    if(shown_cols){
+        hc595_scan(shown_cols, shown_level);
+    }
+}
+
+#else
+#error "unknown DISPLAY_BACKEND"
+#endif
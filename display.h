@@ -0,0 +1,46 @@
+//the LED matrix the grid is shown on, picked at compile time with
+//DISPLAY_BACKEND. every backend has the same few functions below, and
+//only the one picked is built, so main.c calls straight into it.
+//all of them use the ht1632c's three pins on PORTB (see ht1632c.c).
+
+
+//header file with the display stuff
+
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include <stdint.h>
+
+#define DISPLAY_HT1632C 0 //the stock 32x8 board, ht1632c.c
+#define DISPLAY_MAX7219 1 //four 8x8 MAX7219 modules in a chain, max7219.c
+#define DISPLAY_HC595 2 //a 32x8 matrix multiplexed through 74HC595s, hc595.c
+
+#ifndef DISPLAY_BACKEND
+#define DISPLAY_BACKEND DISPLAY_HT1632C
+#endif
+
+//from power on, ends up with every LED off
+void display_init(void);
+
+//only sets the pins up again, for after a watchdog reset when the
+//display itself hasn't been reset and is still showing the grid
+void display_resume(void);
+
+//shows the 32 columns in cols, sending only the ones set in mask
+//(bit x for column x), or all of them
+void display_push(const uint8_t *cols, uint32_t mask);
+void display_push_all(const uint8_t *cols);
+
+//brightness, 0 (dimmest) to 15
+void display_bright(uint8_t level);
+
+#if DISPLAY_BACKEND == DISPLAY_HC595
+//the 74HC595s only light one row at a time, so this has to be called
+//continuously, like refresh_digits(). it goes through every row once.
+#define DISPLAY_NEEDS_REFRESH 1
+void display_refresh(void);
+#else
+#define DISPLAY_NEEDS_REFRESH 0
+#endif
+
+#endif
@@ -0,0 +1,72 @@
+//driver for a 74HC595 multiplexed matrix, see hc595.h
+
+#include "hc595.h"
+
+#include <avr/io.h>
+#include <util/delay_basic.h>
+
+//the same pins as the ht1632c
+#define HC595_PORT PORTB
+#define HC595_DDR DDRB
+#define HC595_RCLK _BV(3)
+#define HC595_SRCLK _BV(4)
+#define HC595_SER _BV(5)
+
+//_delay_loop_2() takes 4 cycles a count
+#define HC595_ROW_COUNTS (HC595_ROW_US * (F_CPU / 4000000UL))
+
+static void hc595_bit(uint8_t on){
+//SER is shifted in on the rising edge of SRCLK
+    HC595_PORT &= ~HC595_SRCLK;
+    if(on){
+        HC595_PORT |= HC595_SER;
+    } else {
+        HC595_PORT &= ~HC595_SER;
+    }
+    HC595_PORT |= HC595_SRCLK;
+}
+
+static void hc595_latch(void){
+//every output changes to what was shifted in on the rising edge of RCLK
+    HC595_PORT |= HC595_RCLK;
+    HC595_PORT &= ~HC595_RCLK;
+}
+
+void hc595_init(void){
+    HC595_PORT &= ~(HC595_RCLK | HC595_SRCLK | HC595_SER);
+    HC595_DDR |= HC595_RCLK | HC595_SRCLK | HC595_SER;
+    hc595_off();
+}
+
+void hc595_row(uint8_t y, const uint8_t *cols){
+    uint8_t bit = 1<<y;
+    uint8_t x = 32;
+    
+    //columns first, so they end up in the shift registers furthest away
+    while(x--){
+        hc595_bit(cols[x] & bit);
+    }
+    //then the rows, row 7 first so row 0 ends up on QA
+    x = 8;
+    while(x--){
+        hc595_bit(x == y);
+    }
+    hc595_latch();
+}
+
+void hc595_off(void){
+    uint8_t i;
+    for(i=0; i<HC595_BITS; i++){
+        hc595_bit(0);
+    }
+    hc595_latch();
+}
+
+void hc595_scan(const uint8_t *cols, uint8_t bright){
+    uint8_t y;
+    for(y=0; y<8; y++){
+        hc595_row(y, cols);
+        _delay_loop_2((uint16_t)(bright + 1) * HC595_ROW_COUNTS);
+    }
+    hc595_off();
+}
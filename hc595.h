@@ -0,0 +1,32 @@
+//driver for a 32x8 LED matrix multiplexed a row at a time through five
+//74HC595 shift registers, on the ht1632c's pins: CS for the latch clock
+//(RCLK), WR for the shift clock (SRCLK) and DATA for the serial input.
+//the four furthest from the mcu drive the 32 column lines, column 31 the
+//furthest, and the nearest one drives the 8 row lines, row 0 on QA. all
+//of them are on when high.
+
+
+//header file with the 74HC595 stuff
+
+#ifndef HC595_H
+#define HC595_H
+
+#include <stdint.h>
+
+#define HC595_BITS (32 + 8) //shifted out for each row
+#define HC595_ROW_US 16 //each row is lit for this many us per brightness step
+
+//sets up the pins and turns every LED off
+void hc595_init(void);
+
+//lights row y of the 32 columns in cols, and no other row
+void hc595_row(uint8_t y, const uint8_t *cols);
+
+//turns every LED off
+void hc595_off(void);
+
+//lights each row of cols in turn for (bright+1)*HC595_ROW_US, then turns
+//them off, so they're all lit for the same time
+void hc595_scan(const uint8_t *cols, uint8_t bright);
+
+#endif
@@ -0,0 +1,610 @@
+//an AVR core on the PC, the ATtiny26's, see avr_sim.h
+
+#include "avr_sim.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define SREG(avr) ((avr)->data[AVR_SIM_IO + AVR_SIM_SREG])
+#define FLAG(avr, f) ((SREG(avr) >> (f)) & 1)
+
+//SREG's bits
+#define FLAG_C 0
+#define FLAG_Z 1
+#define FLAG_N 2
+#define FLAG_V 3
+#define FLAG_S 4
+#define FLAG_H 5
+#define FLAG_T 6
+#define FLAG_I 7
+
+//the register pairs
+#define X 26
+#define Y 28
+#define Z 30
+
+static uint8_t hex_byte(const char *s){
+    unsigned val;
+    sscanf(s, "%2x", &val);
+    return (uint8_t)val;
+}
+
+int avr_sim_load_hex(struct avr_sim *avr, const char *path){
+    char line[600];
+    uint8_t *flash = (uint8_t *)avr->flash;
+    FILE *f = fopen(path, "r");
+
+    if(!f){
+        perror(path);
+        return -1;
+    }
+    memset(avr->flash, 0xff, sizeof(avr->flash));
+    while(fgets(line, sizeof(line), f)){
+        unsigned len, addr, type, i;
+
+        if((line[0] != ':') || (sscanf(line + 1, "%2x%4x%2x",
+                                       &len, &addr, &type) != 3)){
+            continue;
+        }
+        if(type == 1){
+            break; //end of file
+        }
+        if(type != 0){
+            continue; //the segment records, not needed under 64KB
+        }
+        for(i=0; i<len; i++){
+            if(addr + i >= AVR_SIM_FLASH){
+                printf("%s: doesn't fit in %u bytes of flash\n", path,
+                       AVR_SIM_FLASH);
+                fclose(f);
+                return -1;
+            }
+            //the words are little endian in the file, and on the PC
+            flash[addr + i] = hex_byte(line + 9 + i*2);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+void avr_sim_reset(struct avr_sim *avr){
+    avr->pc = 0;
+    avr->cycles = 0;
+    avr->fault = 0;
+    SREG(avr) = 0;
+    AVR_SIM_SP(avr) = AVR_SIM_RAMEND;
+    avr->sp_min = AVR_SIM_RAMEND;
+}
+
+static uint8_t read_data(struct avr_sim *avr, uint16_t addr){
+    if(addr > AVR_SIM_RAMEND){
+        avr->fault = "read past the end of RAM";
+        return 0;
+    }
+    if((addr >= AVR_SIM_IO) && (addr < AVR_SIM_RAM) && avr->io_read
+       && (addr != AVR_SIM_IO + AVR_SIM_SPL)
+       && (addr != AVR_SIM_IO + AVR_SIM_SREG)){
+        return avr->io_read(avr, addr - AVR_SIM_IO);
+    }
+    return avr->data[addr];
+}
+
+static void write_data(struct avr_sim *avr, uint16_t addr, uint8_t val){
+    if(addr > AVR_SIM_RAMEND){
+        avr->fault = "write past the end of RAM";
+        return;
+    }
+    if((addr >= AVR_SIM_IO) && (addr < AVR_SIM_RAM) && avr->io_write
+       && (addr != AVR_SIM_IO + AVR_SIM_SPL)
+       && (addr != AVR_SIM_IO + AVR_SIM_SREG)){
+        avr->io_write(avr, addr - AVR_SIM_IO, val);
+        return;
+    }
+    avr->data[addr] = val;
+}
+
+static void push(struct avr_sim *avr, uint8_t val){
+    uint8_t sp = AVR_SIM_SP(avr);
+
+    if(sp < AVR_SIM_RAM){
+        avr->fault = "the stack ran out of RAM";
+        return;
+    }
+    avr->data[sp] = val;
+    AVR_SIM_SP(avr) = --sp;
+    if(sp < avr->sp_min){
+        avr->sp_min = sp;
+    }
+}
+
+static uint8_t pop(struct avr_sim *avr){
+    uint8_t sp = AVR_SIM_SP(avr);
+
+    if(sp >= AVR_SIM_RAMEND){
+        avr->fault = "popped more than was pushed";
+        return 0;
+    }
+    AVR_SIM_SP(avr) = ++sp;
+    return avr->data[sp];
+}
+
+//return addresses go on the stack low byte last, so it's popped first
+static void push_pc(struct avr_sim *avr, uint16_t pc){
+    push(avr, pc & 0xff);
+    push(avr, pc >> 8);
+}
+
+static uint16_t pop_pc(struct avr_sim *avr){
+    uint16_t pc = (uint16_t)pop(avr) << 8;
+    return pc | pop(avr);
+}
+
+static uint16_t pair(struct avr_sim *avr, uint8_t r){
+    return avr->data[r] | ((uint16_t)avr->data[r + 1] << 8);
+}
+
+static void set_pair(struct avr_sim *avr, uint8_t r, uint16_t val){
+    avr->data[r] = val & 0xff;
+    avr->data[r + 1] = val >> 8;
+}
+
+static void set_flag(struct avr_sim *avr, uint8_t f, uint8_t on){
+    if(on)
+        SREG(avr) |= (1<<f);
+    else
+        SREG(avr) &= ~(1<<f);
+}
+
+//N, Z and S from a result, V already set
+static void nzs(struct avr_sim *avr, uint8_t r){
+    set_flag(avr, FLAG_N, r >> 7);
+    set_flag(avr, FLAG_Z, !r);
+    set_flag(avr, FLAG_S, FLAG(avr, FLAG_N) ^ FLAG(avr, FLAG_V));
+}
+
+static uint8_t add(struct avr_sim *avr, uint8_t d, uint8_t r, uint8_t c){
+    uint8_t res = d + r + c;
+    uint8_t carries = (d & r) | (r & ~res) | (~res & d);
+
+    set_flag(avr, FLAG_H, (carries >> 3) & 1);
+    set_flag(avr, FLAG_C, carries >> 7);
+    set_flag(avr, FLAG_V, ((d & r & ~res) | (~d & ~r & res)) >> 7);
+    nzs(avr, res);
+    return res;
+}
+
+//SUB, CP and the rest. with keep_z (SBC, CPC) Z can only be cleared, so a
+//subtraction spread over several bytes is only zero if they all are
+static uint8_t sub(struct avr_sim *avr, uint8_t d, uint8_t r, uint8_t c,
+                   uint8_t keep_z){
+    uint8_t res = d - r - c;
+    uint8_t borrows = (~d & r) | (r & res) | (res & ~d);
+    uint8_t z = FLAG(avr, FLAG_Z);
+
+    set_flag(avr, FLAG_H, (borrows >> 3) & 1);
+    set_flag(avr, FLAG_C, borrows >> 7);
+    set_flag(avr, FLAG_V, ((d & ~r & ~res) | (~d & r & res)) >> 7);
+    nzs(avr, res);
+    if(keep_z){
+        set_flag(avr, FLAG_Z, !res && z);
+    }
+    return res;
+}
+
+static uint8_t logic(struct avr_sim *avr, uint8_t res){
+    set_flag(avr, FLAG_V, 0);
+    nzs(avr, res);
+    return res;
+}
+
+//LSR, ROR and ASR, bit 7 of the result is top
+static uint8_t shift_right(struct avr_sim *avr, uint8_t d, uint8_t top){
+    uint8_t res = (d >> 1) | (top << 7);
+
+    set_flag(avr, FLAG_C, d & 1);
+    set_flag(avr, FLAG_N, top);
+    set_flag(avr, FLAG_V, top ^ (d & 1));
+    nzs(avr, res);
+    return res;
+}
+
+static uint8_t two_words(uint16_t op){
+//LDS and STS, and the JMP and CALL the ATtiny26 hasn't got
+    return ((op & 0xfc0f) == 0x9000) || ((op & 0xfe0c) == 0x940c);
+}
+
+static uint16_t fetch(struct avr_sim *avr){
+    if(avr->pc >= AVR_SIM_FLASH / 2){
+        avr->fault = "ran off the end of flash";
+        return 0;
+    }
+    return avr->flash[avr->pc++];
+}
+
+static void skip(struct avr_sim *avr){
+    uint16_t next = fetch(avr);
+
+    avr->cycles++;
+    if(two_words(next)){
+        avr->pc++;
+        avr->cycles++;
+    }
+}
+
+//LD, LDD, ST and STD: the address, with the pointer moved for X+, -Y and
+//the like
+static uint16_t pointer(struct avr_sim *avr, uint8_t p, uint8_t mode){
+    uint16_t addr = pair(avr, p);
+
+    if(mode == 1){
+        set_pair(avr, p, addr + 1); //post increment
+    } else if(mode == 2){
+        set_pair(avr, p, --addr); //pre decrement
+    }
+    return addr;
+}
+
+static uint8_t ld_st(struct avr_sim *avr, uint16_t op, uint8_t d){
+//the 1001 00xd dddd pppp ones, returns 0 if op isn't one of them
+    uint8_t store = (op >> 9) & 1;
+    uint8_t mode = op & 3;
+    uint8_t p;
+    uint16_t addr;
+
+    switch(op & 0xc){
+        case 0x0:
+            if(mode == 0){
+                //LDS and STS
+                addr = fetch(avr);
+                avr->cycles++;
+                if(store)
+                    write_data(avr, addr, avr->data[d]);
+                else
+                    avr->data[d] = read_data(avr, addr);
+                return 1;
+            }
+            p = Z;
+            break;
+        case 0x4:
+            if(store || (mode > 1)){
+                return 0; //ELPM, XCH and the like
+            }
+            //LPM Rd,Z and LPM Rd,Z+
+            addr = pointer(avr, Z, mode);
+            avr->data[d] = ((uint8_t *)avr->flash)[addr % AVR_SIM_FLASH];
+            avr->cycles += 2;
+            return 1;
+        case 0x8:
+            p = Y;
+            break;
+        default:
+            if(mode == 3){
+                //PUSH and POP
+                if(store)
+                    push(avr, avr->data[d]);
+                else
+                    avr->data[d] = pop(avr);
+                avr->cycles++;
+                return 1;
+            }
+            p = X;
+            break;
+    }
+    //LD Y and LD Z are LDD with q=0, these are only the X+, -Y and so on
+    if((mode == 3) || (!mode && (p != X))){
+        return 0;
+    }
+    addr = pointer(avr, p, mode);
+    if(store)
+        write_data(avr, addr, avr->data[d]);
+    else
+        avr->data[d] = read_data(avr, addr);
+    avr->cycles++;
+    return 1;
+}
+
+static uint8_t one_reg(struct avr_sim *avr, uint16_t op, uint8_t d){
+//the 1001 010d dddd 0xxx ones and DEC, returns 0 if op isn't one of them
+    uint8_t v = avr->data[d];
+
+    switch(op & 0xf){
+        case 0x0: //COM
+            avr->data[d] = logic(avr, ~v);
+            set_flag(avr, FLAG_C, 1);
+            return 1;
+        case 0x1: //NEG
+            avr->data[d] = sub(avr, 0, v, 0, 0);
+            return 1;
+        case 0x2: //SWAP
+            avr->data[d] = (v << 4) | (v >> 4);
+            return 1;
+        case 0x3: //INC
+            set_flag(avr, FLAG_V, v == 0x7f);
+            avr->data[d] = ++v;
+            nzs(avr, v);
+            return 1;
+        case 0x5: //ASR
+            avr->data[d] = shift_right(avr, v, v >> 7);
+            return 1;
+        case 0x6: //LSR
+            avr->data[d] = shift_right(avr, v, 0);
+            return 1;
+        case 0x7: //ROR
+            avr->data[d] = shift_right(avr, v, FLAG(avr, FLAG_C));
+            return 1;
+        case 0xa: //DEC
+            set_flag(avr, FLAG_V, v == 0x80);
+            avr->data[d] = --v;
+            nzs(avr, v);
+            return 1;
+    }
+    return 0;
+}
+
+static uint8_t no_regs(struct avr_sim *avr, uint16_t op){
+//1001 010x xxxx 1000 and 1001 010x 0000 1001, returns 0 for the rest
+    switch(op){
+        case 0x9508: //RET
+        case 0x9518: //RETI
+            avr->pc = pop_pc(avr);
+            avr->cycles += 3;
+            if(op == 0x9518)
+                set_flag(avr, FLAG_I, 1);
+            return 1;
+        case 0x9588: //SLEEP, the program running it decides when it wakes
+        case 0x95a8: //WDR
+            return 1;
+        case 0x95c8: //LPM
+            avr->data[0] = ((uint8_t *)avr->flash)[pair(avr, Z) % AVR_SIM_FLASH];
+            avr->cycles += 2;
+            return 1;
+        case 0x9409: //IJMP
+            avr->pc = pair(avr, Z);
+            avr->cycles++;
+            return 1;
+        case 0x9509: //ICALL
+            push_pc(avr, avr->pc);
+            avr->pc = pair(avr, Z);
+            avr->cycles += 2;
+            return 1;
+    }
+    if((op & 0xff0f) == 0x9408){
+        //BSET and BCLR, SEC, CLI and the rest
+        set_flag(avr, (op >> 4) & 7, !(op & 0x80));
+        return 1;
+    }
+    return 0;
+}
+
+uint8_t avr_sim_step(struct avr_sim *avr){
+    uint16_t op = fetch(avr);
+    uint8_t d = (op >> 4) & 0x1f; //Rd in most of them
+    uint8_t r = (op & 0xf) | ((op >> 5) & 0x10); //Rr
+    uint8_t dh = 16 + ((op >> 4) & 0xf); //Rd for the ones with an immediate
+    uint8_t k = (op & 0xf) | ((op >> 4) & 0xf0); //their K
+    uint8_t io = (op & 0xf) | ((op >> 5) & 0x30); //IN and OUT's A
+    uint8_t bit = op & 7;
+    uint16_t w;
+
+    if(avr->fault){
+        return 1;
+    }
+    avr->cycles++;
+
+    switch(op >> 12){
+        case 0x0:
+            switch((op >> 10) & 3){
+                case 0:
+                    if(op){
+                        avr->fault = "MOVW, MULS or FMUL, not on the ATtiny26";
+                    }
+                    break; //NOP
+                case 1: //CPC
+                    sub(avr, avr->data[d], avr->data[r], FLAG(avr, FLAG_C), 1);
+                    break;
+                case 2: //SBC
+                    avr->data[d] = sub(avr, avr->data[d], avr->data[r],
+                                       FLAG(avr, FLAG_C), 1);
+                    break;
+                case 3: //ADD, LSL
+                    avr->data[d] = add(avr, avr->data[d], avr->data[r], 0);
+                    break;
+            }
+            break;
+        case 0x1:
+            switch((op >> 10) & 3){
+                case 0: //CPSE
+                    if(avr->data[d] == avr->data[r])
+                        skip(avr);
+                    break;
+                case 1: //CP
+                    sub(avr, avr->data[d], avr->data[r], 0, 0);
+                    break;
+                case 2: //SUB
+                    avr->data[d] = sub(avr, avr->data[d], avr->data[r], 0, 0);
+                    break;
+                case 3: //ADC, ROL
+                    avr->data[d] = add(avr, avr->data[d], avr->data[r],
+                                       FLAG(avr, FLAG_C));
+                    break;
+            }
+            break;
+        case 0x2:
+            switch((op >> 10) & 3){
+                case 0: //AND, TST
+                    avr->data[d] = logic(avr, avr->data[d] & avr->data[r]);
+                    break;
+                case 1: //EOR, CLR
+                    avr->data[d] = logic(avr, avr->data[d] ^ avr->data[r]);
+                    break;
+                case 2: //OR
+                    avr->data[d] = logic(avr, avr->data[d] | avr->data[r]);
+                    break;
+                case 3: //MOV
+                    avr->data[d] = avr->data[r];
+                    break;
+            }
+            break;
+        case 0x3: //CPI
+            sub(avr, avr->data[dh], k, 0, 0);
+            break;
+        case 0x4: //SBCI
+            avr->data[dh] = sub(avr, avr->data[dh], k, FLAG(avr, FLAG_C), 1);
+            break;
+        case 0x5: //SUBI
+            avr->data[dh] = sub(avr, avr->data[dh], k, 0, 0);
+            break;
+        case 0x6: //ORI, SBR
+            avr->data[dh] = logic(avr, avr->data[dh] | k);
+            break;
+        case 0x7: //ANDI, CBR
+            avr->data[dh] = logic(avr, avr->data[dh] & k);
+            break;
+        case 0x8:
+        case 0xa:
+            //LDD and STD, Y or Z plus q
+            w = pair(avr, (op & 8) ? Y : Z)
+                + ((op & 7) | ((op >> 7) & 0x18) | ((op >> 8) & 0x20));
+            if(op & 0x200)
+                write_data(avr, w, avr->data[d]);
+            else
+                avr->data[d] = read_data(avr, w);
+            avr->cycles++;
+            break;
+        case 0x9:
+            if((op & 0xfc00) == 0x9000){
+                if(!ld_st(avr, op, d))
+                    avr->fault = "a load or store the ATtiny26 hasn't got";
+            } else if((op & 0xfe00) == 0x9400){
+                if(!one_reg(avr, op, d) && !no_regs(avr, op))
+                    avr->fault = "JMP, CALL or something else the ATtiny26 hasn't got";
+            } else if((op & 0xfe00) == 0x9600){
+                //ADIW and SBIW, on r24, r26, r28 or r30
+                uint8_t p = 24 + ((op >> 3) & 6);
+                uint16_t v = pair(avr, p);
+                uint8_t kw = (op & 0xf) | ((op >> 2) & 0x30);
+                uint8_t hi = v >> 15;
+
+                w = (op & 0x100) ? v - kw : v + kw;
+                set_pair(avr, p, w);
+                if(op & 0x100){
+                    set_flag(avr, FLAG_V, hi & (!(w >> 15)));
+                    set_flag(avr, FLAG_C, (w >> 15) & (!hi));
+                } else {
+                    set_flag(avr, FLAG_V, (!hi) & (w >> 15));
+                    set_flag(avr, FLAG_C, (!(w >> 15)) & hi);
+                }
+                set_flag(avr, FLAG_N, w >> 15);
+                set_flag(avr, FLAG_Z, !w);
+                set_flag(avr, FLAG_S, FLAG(avr, FLAG_N) ^ FLAG(avr, FLAG_V));
+                avr->cycles++;
+            } else if((op & 0xfc00) == 0x9800){
+                //CBI, SBIC, SBI and SBIS, on the first 32 I/O registers
+                uint8_t a = AVR_SIM_IO + ((op >> 3) & 0x1f);
+                uint8_t v = read_data(avr, a);
+
+                switch((op >> 8) & 3){
+                    case 0:
+                        write_data(avr, a, v & ~(1<<bit));
+                        avr->cycles++;
+                        break;
+                    case 1:
+                        if(!(v & (1<<bit)))
+                            skip(avr);
+                        break;
+                    case 2:
+                        write_data(avr, a, v | (1<<bit));
+                        avr->cycles++;
+                        break;
+                    case 3:
+                        if(v & (1<<bit))
+                            skip(avr);
+                        break;
+                }
+            } else {
+                avr->fault = "MUL, not on the ATtiny26";
+            }
+            break;
+        case 0xb:
+            if(op & 0x800)
+                write_data(avr, AVR_SIM_IO + io, avr->data[d]); //OUT
+            else
+                avr->data[d] = read_data(avr, AVR_SIM_IO + io); //IN
+            break;
+        case 0xc: //RJMP
+        case 0xd: //RCALL
+            if(op & 0x1000){
+                push_pc(avr, avr->pc);
+                avr->cycles++;
+            }
+            //a 12 bit offset, wrapping round the 1K words of flash
+            avr->pc = (avr->pc + (op & 0xfff)) % (AVR_SIM_FLASH / 2);
+            avr->cycles++;
+            break;
+        case 0xe: //LDI, SER
+            avr->data[dh] = k;
+            break;
+        case 0xf:
+            if(!(op & 0x800)){
+                //BRBS and BRBC, BREQ, BRCC and the rest
+                if(FLAG(avr, bit) == !(op & 0x400)){
+                    int8_t off = (int8_t)((op >> 2) & 0xfe) >> 1;
+                    avr->pc += off;
+                    avr->cycles++;
+                }
+            } else if(op & 8){
+                avr->fault = "not an instruction";
+            } else {
+                switch((op >> 9) & 3){
+                    case 0: //BLD
+                        if(FLAG(avr, FLAG_T))
+                            avr->data[d] |= (1<<bit);
+                        else
+                            avr->data[d] &= ~(1<<bit);
+                        break;
+                    case 1: //BST
+                        set_flag(avr, FLAG_T, (avr->data[d] >> bit) & 1);
+                        break;
+                    case 2: //SBRC
+                        if(!(avr->data[d] & (1<<bit)))
+                            skip(avr);
+                        break;
+                    case 3: //SBRS
+                        if(avr->data[d] & (1<<bit))
+                            skip(avr);
+                        break;
+                }
+            }
+            break;
+    }
+    return avr->fault != 0;
+}
+
+uint8_t avr_sim_irq(struct avr_sim *avr, uint8_t vector){
+    if(!FLAG(avr, FLAG_I)){
+        return 0;
+    }
+    push_pc(avr, avr->pc);
+    set_flag(avr, FLAG_I, 0);
+    avr->pc = vector; //the vectors are one RJMP each
+    avr->cycles += 4;
+    return 1;
+}
+
+uint8_t avr_sim_call(struct avr_sim *avr, uint16_t addr,
+                     unsigned long max_cycles){
+    unsigned long end = avr->cycles + max_cycles;
+
+    push_pc(avr, AVR_SIM_RETURN);
+    avr->pc = addr / 2;
+    while(avr->pc != AVR_SIM_RETURN){
+        if(avr_sim_step(avr)){
+            return 1;
+        }
+        if(avr->cycles > end){
+            avr->fault = "didn't return";
+            return 1;
+        }
+    }
+    return 0;
+}
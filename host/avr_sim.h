@@ -0,0 +1,73 @@
+//an AVR core on the PC, the ATtiny26's: the avr2 instructions (no MOVW,
+//MUL, JMP or CALL) plus LPM Rd,Z, 2KB of flash, and the 32 registers, 64
+//I/O registers and 128 bytes of RAM in one data space from 0 to 0xdf, with
+//an 8 bit stack pointer. it runs code built by avr-gcc from an Intel hex
+//file, one instruction at a time, counting cycles. anything the ATtiny26
+//couldn't do, an instruction it hasn't got or the stack running out of
+//RAM, stops it with a fault saying what.
+//
+//it has no peripherals of its own. the I/O registers are plain memory
+//unless the program running it hooks io_read/io_write, and interrupts only
+//happen when it calls avr_sim_irq().
+
+#ifndef AVR_SIM_H
+#define AVR_SIM_H
+
+#include <stdint.h>
+
+//bytes, a power of 2. can be made bigger to run an image from a compiler
+//that doesn't get it into the ATtiny26's 2048
+#ifndef AVR_SIM_FLASH
+#define AVR_SIM_FLASH 2048
+#endif
+#define AVR_SIM_IO 0x20 //data address of I/O register 0
+#define AVR_SIM_RAM 0x60 //first byte of RAM
+#define AVR_SIM_RAMEND 0xdf //last byte of RAM, where the stack starts
+
+//I/O addresses, as IN and OUT use them
+#define AVR_SIM_SPL 0x3d
+#define AVR_SIM_SREG 0x3f
+
+//where avr_sim_call() returns to, a word address past the end of flash
+#define AVR_SIM_RETURN 0x7fff
+
+struct avr_sim {
+    uint16_t flash[AVR_SIM_FLASH / 2];
+    uint8_t data[AVR_SIM_RAMEND + 1]; //r0-r31, I/O, RAM
+    uint16_t pc; //in words
+    unsigned long cycles;
+    uint8_t sp_min; //lowest the stack pointer has been since the reset
+    const char *fault; //why it stopped, 0 while it's running fine
+
+    //for the I/O registers other than SPL and SREG, addr is as IN and
+    //OUT use it. 0 to keep them in data[] like RAM
+    uint8_t (*io_read)(struct avr_sim *avr, uint8_t addr);
+    void (*io_write)(struct avr_sim *avr, uint8_t addr, uint8_t val);
+};
+
+//the registers, and the stack pointer
+#define AVR_SIM_R(avr, n) ((avr)->data[n])
+#define AVR_SIM_SP(avr) ((avr)->data[AVR_SIM_IO + AVR_SIM_SPL])
+
+//flash gets 0xffff everywhere and the hex file's bytes where it says,
+//returns 0, or -1 with a message printed if it can't
+int avr_sim_load_hex(struct avr_sim *avr, const char *path);
+
+//what a reset does: pc 0, SREG 0, the stack pointer at the top of RAM.
+//RAM and the registers keep whatever they had, like on the chip
+void avr_sim_reset(struct avr_sim *avr);
+
+//runs one instruction, returns 0, or 1 and sets fault if it can't
+uint8_t avr_sim_step(struct avr_sim *avr);
+
+//interrupt vector number vector, like the chip's interrupt logic, if the
+//I bit is set. returns 1 if it was taken
+uint8_t avr_sim_irq(struct avr_sim *avr, uint8_t vector);
+
+//calls the function at byte address addr with the registers as they are,
+//and runs until it returns or max_cycles go by. returns 0, or 1 with fault
+//set if it didn't come back
+uint8_t avr_sim_call(struct avr_sim *avr, uint16_t addr,
+                     unsigned long max_cycles);
+
+#endif
@@ -0,0 +1,110 @@
+//works out how long it takes from power on until the first Game of Life
+//frame is on the display. it runs main.c's own start up, up to where it
+//turns interrupts on, with the real ht1632c.c clocking its bits into the
+//pin level ht1632c in host/ht1632c_sim.c, and counts them. it checks the
+//LEDs never come on with the junk the chip's RAM has at power on, and
+//that the first frame is on the display by the time main() is done.
+//only the display traffic is counted, the ADC reading for grid_rand and the
+//new_seed() calls add a little more on the real thing. built with
+//LIFE_WARM_RESTART it does the same for a watchdog reset too.
+//`make boot_time` builds it for the variants in BOOT_VARIANTS and runs it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <setjmp.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "life.h"
+#include "host/ht1632c_sim.h"
+
+#define GEN_TICKS_US (64UL * 8192UL) //first generation tick, see main.c
+
+//main.c's, built with -Dmain=firmware_main
+int firmware_main(void);
+void next_generation(void);
+extern uint16_t generation_count;
+
+static jmp_buf started;
+
+void sim_sei(void){
+//main() has got as far as its loop, stop there
+    longjmp(started, 1);
+}
+
+static void start(void){
+    if(!setjmp(started))
+        firmware_main();
+}
+
+static int showing_fb(const char *when){
+    uint8_t x;
+    for(x=0;x<X_AXIS_LEN;x++){
+        if(ht1632c_sim_column(x) != fb[x]){
+            printf("%s: column %u didn't make it to the display\n", when, x);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void){
+    unsigned long lit_bits, lit_us, frame_bits, frame_us, old_clear_bits;
+    uint8_t junk;
+
+    ht1632c_sim_reset();
+    start();
+    lit_bits = ht1632c_sim_lit_bits();
+    lit_us = (lit_bits * HT1632C_SIM_NS_PER_BIT) / 1000;
+    frame_bits = ht1632c_sim_bits();
+    frame_us = ht1632c_sim_us();
+    junk = ht1632c_sim_junk_shown();
+    if(!lit_bits){
+        printf("the LEDs never came on\n");
+        return 1;
+    }
+    if(!showing_fb("power on")){
+        return 1;
+    }
+
+    printf("LEDs on:           %5lu bits %6lu us%s\n",
+           lit_bits, lit_us, junk ? " (junk in RAM when LEDs came on!)" : "");
+    printf("first frame:       %5lu bits %6lu us after power on\n",
+           frame_bits, frame_us);
+
+    //what it used to be: 64 single nibble writes to clear, and the first
+    //frame only after the first generation's worth of timer1 overflows
+    old_clear_bits = 64UL * (3 + 7 + 4);
+    printf("before (64 x ht1632c_data4 clear, first push on timer1): "
+           "%lu bits to clear, first frame ~%lu us\n",
+           old_clear_bits, GEN_TICKS_US + frame_us);
+
+    #if LIFE_WARM_RESTART
+    {
+        uint16_t gens;
+        uint8_t i;
+
+        //a few generations, then the watchdog goes off between two
+        for(i=0;i<5;i++){
+            next_generation();
+        }
+        gens = generation_count;
+        ht1632c_sim_mcu_reset();
+        MCUSR = (1<<WDRF);
+        ht1632c_sim_bits_clear();
+        start();
+        if(generation_count != gens){
+            printf("warm restart: started from cold instead\n");
+            return 1;
+        }
+        if(!showing_fb("warm restart")){
+            return 1;
+        }
+        printf("warm restart:      %5lu bits %6lu us after the watchdog reset\n",
+               ht1632c_sim_bits(), ht1632c_sim_us());
+    }
+    #endif
+
+    return junk ? 1 : 0;
+}
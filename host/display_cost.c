@@ -0,0 +1,96 @@
+//what it costs to get the grid onto each kind of display, in bits clocked
+//out, going through display.c and the drivers, with the displays
+//simulated in host/ (the ht1632c at the level of its pins).
+//it runs random grids through life_step() like main.c does, pushing the
+//columns that changed each generation, and checks the display ends up
+//showing the grid. build it once for each DISPLAY_BACKEND, which is what
+//`make display_cost` does.
+//
+//usage: display_cost [grids [generations]]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "life.h"
+#include "display.h"
+#include "host/ht1632c_sim.h"
+#include "host/display_sim.h"
+
+#if DISPLAY_BACKEND == DISPLAY_HT1632C
+#define NAME "ht1632c"
+#define SIM_BITS() ht1632c_sim_bits()
+#define SIM_BITS_CLEAR() ht1632c_sim_bits_clear()
+#define SIM_COLUMN(x) ht1632c_sim_column(x)
+#elif DISPLAY_BACKEND == DISPLAY_MAX7219
+#define NAME "max7219"
+#define SIM_BITS() display_sim_bits
+#define SIM_BITS_CLEAR() (display_sim_bits = 0)
+#define SIM_COLUMN(x) max7219_sim_column(x)
+#else
+#define NAME "74hc595"
+#define SIM_BITS() display_sim_bits
+#define SIM_BITS_CLEAR() (display_sim_bits = 0)
+#define SIM_COLUMN(x) hc595_sim_column(x)
+#endif
+
+static int shown(void){
+//1 if the display is showing fb
+    uint8_t x;
+#if DISPLAY_NEEDS_REFRESH
+    display_refresh();
+#endif
+    for(x=0; x<X_AXIS_LEN; x++)
+        if(SIM_COLUMN(x) != fb[x])
+            return 0;
+    return 1;
+}
+
+int main(int argc, char **argv){
+    unsigned long grids = 1000, gens = 200;
+    unsigned long g, n, init_bits, all_bits = 0, push_bits = 0, pushes = 0;
+    uint8_t x;
+
+    if(argc > 1)
+        grids = strtoul(argv[1], NULL, 0);
+    if(argc > 2)
+        gens = strtoul(argv[2], NULL, 0);
+
+    ht1632c_sim_reset();
+    display_sim_reset();
+    display_init();
+    init_bits = SIM_BITS();
+
+    for(g=0; g<grids; g++){
+        for(x=0; x<X_AXIS_LEN; x++)
+            fb[x] = rand();
+        life_all_changed();
+        SIM_BITS_CLEAR();
+        display_push_all(fb);
+        all_bits = SIM_BITS();
+        if(!shown()){
+            printf(NAME ": grid %lu didn't make it to the display\n", g);
+            return 1;
+        }
+        for(n=0; n<gens; n++){
+            life_step();
+            SIM_BITS_CLEAR();
+            display_push(fb, life_changed);
+            push_bits += SIM_BITS();
+            pushes++;
+            if(!shown()){
+                printf(NAME ": grid %lu generation %lu didn't make it to the display\n", g, n);
+                return 1;
+            }
+        }
+    }
+
+    printf("%-8s init %5lu bits, whole frame %4lu bits, changed columns %6.1f bits a generation",
+           NAME, init_bits, all_bits, (double)push_bits / pushes);
+#if DISPLAY_NEEDS_REFRESH
+    SIM_BITS_CLEAR();
+    display_refresh();
+    printf(",\n         plus %lu bits every refresh, all the time", SIM_BITS());
+#endif
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+//stand-ins for max7219.c and hc595.c on the PC, see display_sim.h
+
+#include "display_sim.h"
+
+#include <stdlib.h>
+
+unsigned long display_sim_bits;
+uint8_t max7219_sim_digits[MAX7219_CHAIN][8];
+
+static uint8_t hc595_lit[8][32]; //what each row lit in the last scan
+
+void display_sim_reset(void){
+    uint8_t m, d;
+    for(m=0; m<MAX7219_CHAIN; m++)
+        for(d=0; d<8; d++)
+            max7219_sim_digits[m][d] = rand();
+    display_sim_bits = 0;
+}
+
+uint8_t max7219_sim_column(uint8_t x){
+    return max7219_sim_digits[(x / 8) % MAX7219_CHAIN][x % 8];
+}
+
+uint8_t hc595_sim_column(uint8_t x){
+    uint8_t y, col = 0;
+    for(y=0; y<8; y++)
+        if(hc595_lit[y][x & 31])
+            col |= 1<<y;
+    return col;
+}
+
+void max7219_init_pins(void){
+}
+
+void max7219_init(void){
+    uint8_t d;
+    //the same loads as max7219.c
+    max7219_all(MAX7219_TEST, 0);
+    max7219_all(MAX7219_DECODE, 0);
+    max7219_all(MAX7219_SCAN_LIMIT, 7);
+    max7219_all(MAX7219_INTENSITY, 7);
+    for(d=0; d<8; d++)
+        max7219_all(MAX7219_DIGIT0 + d, 0);
+    max7219_all(MAX7219_SHUTDOWN, 1);
+}
+
+void max7219_all(uint8_t reg, uint8_t val){
+    uint8_t m;
+    display_sim_bits += 16UL * MAX7219_CHAIN;
+    if((reg >= MAX7219_DIGIT0) && (reg < MAX7219_DIGIT0 + 8))
+        for(m=0; m<MAX7219_CHAIN; m++)
+            max7219_sim_digits[m][reg - MAX7219_DIGIT0] = val;
+}
+
+void max7219_digit(uint8_t dig, const uint8_t *cols){
+    uint8_t m;
+    display_sim_bits += 16UL * MAX7219_CHAIN;
+    for(m=0; m<MAX7219_CHAIN; m++)
+        max7219_sim_digits[m][dig] = cols[m*8];
+}
+
+void hc595_init(void){
+    hc595_off();
+}
+
+void hc595_row(uint8_t y, const uint8_t *cols){
+    uint8_t x;
+    display_sim_bits += HC595_BITS;
+    for(x=0; x<32; x++)
+        hc595_lit[y & 7][x] = !!(cols[x] & (1<<y));
+}
+
+void hc595_off(void){
+    display_sim_bits += HC595_BITS;
+}
+
+void hc595_scan(const uint8_t *cols, uint8_t bright){
+    uint8_t y;
+    (void)bright;
+    for(y=0; y<8; y++)
+        hc595_row(y, cols);
+    hc595_off();
+}
@@ -0,0 +1,29 @@
+//stand-ins for max7219.c and hc595.c on the PC (host/ht1632c_sim.c is a
+//chip on the ht1632c.c driver's pins, these replace the drivers). they
+//have the same functions as max7219.h and hc595.h, but keep what
+//each display would be showing and count the bits clocked out.
+
+#ifndef DISPLAY_SIM_H
+#define DISPLAY_SIM_H
+
+#include <stdint.h>
+
+#include "max7219.h"
+#include "hc595.h"
+
+//bits shifted out (on CLK or SRCLK) since the last display_sim_reset()
+extern unsigned long display_sim_bits;
+
+//the MAX7219s' digit registers, module 0 is the one nearest the mcu
+extern uint8_t max7219_sim_digits[MAX7219_CHAIN][8];
+
+//puts junk in the MAX7219s' digit registers, as at power on
+void display_sim_reset(void);
+
+//column x as the MAX7219s show it
+uint8_t max7219_sim_column(uint8_t x);
+
+//column x as the last hc595_scan() showed it, going by which rows it lit
+uint8_t hc595_sim_column(uint8_t x);
+
+#endif
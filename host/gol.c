@@ -0,0 +1,98 @@
+//the library side of gol.h, a grid at a time through life.c's globals
+
+#include <string.h>
+
+#include "gol.h"
+
+int gol_check(unsigned config, size_t grid_size){
+    return (config == GOL_CONFIG) && (grid_size == sizeof(struct gol_grid));
+}
+
+static void load(const struct gol_grid *g){
+    memcpy(fb, g->cells, GOL_WIDTH);
+    life_changed = g->changed;
+    life_stag = g->stag;
+    #if LIFE_SHIP_CHECK
+    life_ship = g->ship;
+    #endif
+}
+
+static void save(struct gol_grid *g){
+    memcpy(g->cells, fb, GOL_WIDTH);
+    g->changed = life_changed;
+    g->stag = life_stag;
+    #if LIFE_SHIP_CHECK
+    g->ship = life_ship;
+    #endif
+}
+
+static void start(struct gol_grid *g){
+//what reset_grid() does after writing the new grid
+    life_all_changed();
+    life_stagnant_clear();
+    #if LIFE_SHIP_CHECK
+    life_translated_reset();
+    #endif
+    save(g);
+    g->generations = 0;
+    g->diff = 0;
+    g->reset = 0;
+}
+
+void gol_seed(struct gol_grid *g, uint16_t seed){
+    life_seed(seed);
+    start(g);
+}
+
+void gol_set(struct gol_grid *g, const uint8_t cells[GOL_WIDTH]){
+    memcpy(fb, cells, GOL_WIDTH);
+    start(g);
+}
+
+size_t gol_step_many(struct gol_grid *grids, size_t n,
+                     unsigned long generations){
+    size_t i, going=0;
+    unsigned long gen;
+
+    for(i=0; i<n; i++){
+        struct gol_grid *g = &grids[i];
+
+        if(g->reset){
+            continue;
+        }
+        load(g);
+        for(gen=0; gen<generations; gen++){
+            uint8_t reset;
+
+            g->diff = life_step();
+            g->generations++;
+            reset = life_stagnant(g->diff);
+            #if LIFE_SHIP_CHECK
+            if(life_translated()){
+                reset = 1;
+            }
+            #endif
+            if(reset){
+                g->reset = 1;
+                break;
+            }
+        }
+        save(g);
+        if(!g->reset){
+            going++;
+        }
+    }
+    return going;
+}
+
+uint16_t gol_population(const struct gol_grid *g){
+    uint16_t pop=0;
+    uint8_t x, col;
+
+    for(x=0; x<GOL_WIDTH; x++){
+        for(col=g->cells[x]; col; col&=col-1){
+            pop++;
+        }
+    }
+    return pop;
+}
@@ -0,0 +1,67 @@
+//the Game of Life from life.c as a library for PC programs, so anything
+//that wants to run grids the way the board does (analysis tools, seed
+//explorers, checks) can link it rather than copying bits of main.c.
+//`make libgol` builds build/host/libgol.a and libgol.so from life.c and
+//gol.c, with the same LIFE_ options as everything else unless GOL_CFLAGS
+//says otherwise. a program using it has to be built with the same
+//options, gol_check() catches it if it isn't.
+//
+//life.c works on the one grid in fb, so gol_step_many() swaps each grid
+//in and out of it. that means it isn't thread safe, and nothing else
+//should be using fb or the other life_ globals while it runs.
+
+#ifndef GOL_H
+#define GOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "life.h"
+
+#if (LIFE_ENGINE == LIFE_ENGINE_DISPLAY) || LIFE_HALO
+#error "the library needs the grid in fb and no halo"
+#endif
+
+#define GOL_WIDTH X_AXIS_LEN
+#define GOL_HEIGHT Y_AXIS_LEN
+
+//one grid, with everything the board keeps about it between generations
+struct gol_grid {
+    uint8_t cells[GOL_WIDTH]; //columns like fb, bit 0 is the top row
+    uint32_t changed; //life_changed
+    struct life_stagnation stag; //life_stag
+#if LIFE_SHIP_CHECK
+    struct life_ship ship; //life_ship
+#endif
+    unsigned long generations; //stepped so far
+    uint8_t diff; //difference from the last generation
+    uint8_t reset; //set on the generation the board would have reset it,
+                   //gol_step_many() leaves it alone after that
+};
+
+//the options that change what a grid does or how big struct gol_grid is
+#define GOL_CONFIG ((LIFE_TOPOLOGY) | ((LIFE_ENGINE) << 2) | \
+                    ((LIFE_STAGNANT) << 4) | ((LIFE_SHIP_CHECK) << 5))
+
+//returns 1 if the library was built with the same options as the caller
+#define GOL_CHECK() gol_check(GOL_CONFIG, sizeof(struct gol_grid))
+int gol_check(unsigned config, size_t grid_size);
+
+//starts g off as the grid made from seed, like reset_grid() in main.c
+void gol_seed(struct gol_grid *g, uint16_t seed);
+
+//starts g off as cells, GOL_WIDTH columns
+void gol_set(struct gol_grid *g, const uint8_t cells[GOL_WIDTH]);
+
+//runs each of the n grids for up to generations more generations, exactly
+//like get_new_states() on the board: life_step(), then life_stagnant()
+//and the spaceship check. a grid stops when they'd have reset it, with
+//reset set. it can be called again to carry on from where it left off,
+//and returns how many of the grids are still going.
+size_t gol_step_many(struct gol_grid *grids, size_t n,
+                     unsigned long generations);
+
+//how many cells of g are alive
+uint16_t gol_population(const struct gol_grid *g);
+
+#endif
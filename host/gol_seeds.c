@@ -0,0 +1,127 @@
+//a seed explorer built on the library in gol.h, and a check of the
+//library itself. every 16 bit seed's grid is run until the board would
+//reset it, all of them at once with gol_step_many(), and it prints how
+//long they last and the seeds that last longest. the same seeds are also
+//run again a few generations at a time, which has to come out exactly the
+//same, or gol_step_many() isn't keeping everything life.c needs.
+//build and run it with `make gol_seeds`.
+//
+//usage: gol_seeds [generations [best]]
+//  generations: how long a grid may run for, default 3000
+//  best: how many of the longest lasting seeds to print, default 10
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gol.h"
+
+#define SEEDS 65535 //0 is the same grid as 1
+#define CHUNK 7 //generations at a time for the second run
+
+struct lifetime {
+    uint16_t seed;
+    unsigned long generations;
+    uint8_t reset;
+};
+
+static int by_lifetime(const void *a, const void *b){
+//longest first, then lowest seed
+    const struct lifetime *la = a, *lb = b;
+    if(la->generations != lb->generations){
+        return (la->generations < lb->generations) ? 1 : -1;
+    }
+    return (int)la->seed - (int)lb->seed;
+}
+
+static int same(const struct gol_grid *a, const struct gol_grid *b){
+//field by field, there's padding in the structs
+    return !memcmp(a->cells, b->cells, GOL_WIDTH) &&
+           (a->changed == b->changed) && (a->diff == b->diff) &&
+           (a->generations == b->generations) && (a->reset == b->reset);
+}
+
+int main(int argc, char **argv){
+    unsigned long max_gens = 3000, best = 10;
+    unsigned long gen, buckets[8] = { 0 };
+    struct gol_grid *once, *chunked;
+    struct lifetime *lives;
+    size_t i, going;
+    double total=0;
+
+    if(argc > 1){
+        max_gens = strtoul(argv[1], NULL, 0);
+    }
+    if(argc > 2){
+        best = strtoul(argv[2], NULL, 0);
+    }
+    if(!GOL_CHECK()){
+        printf("libgol was built with other LIFE_ options\n");
+        return 1;
+    }
+
+    once = malloc(SEEDS * sizeof(*once));
+    chunked = malloc(SEEDS * sizeof(*chunked));
+    lives = malloc(SEEDS * sizeof(*lives));
+    if(!once || !chunked || !lives){
+        printf("out of memory\n");
+        return 1;
+    }
+    for(i=0; i<SEEDS; i++){
+        gol_seed(&once[i], i + 1);
+        gol_seed(&chunked[i], i + 1);
+    }
+
+    going = gol_step_many(once, SEEDS, max_gens);
+    for(gen=0; gen<max_gens; gen+=CHUNK){
+        unsigned long n = (max_gens - gen < CHUNK) ? max_gens - gen : CHUNK;
+        if(!gol_step_many(chunked, SEEDS, n)){
+            break;
+        }
+    }
+    for(i=0; i<SEEDS; i++){
+        if(!same(&once[i], &chunked[i])){
+            printf("MISMATCH: seed %lu, %lu generations in one go, %lu %u in chunks of %u\n",
+                   (unsigned long)i + 1, once[i].generations,
+                   chunked[i].generations, chunked[i].reset, CHUNK);
+            return 1;
+        }
+    }
+    printf("%u seeds, stepped in one go and %u generations at a time agree\n",
+           SEEDS, CHUNK);
+
+    //how long they lasted, in powers of 4
+    for(i=0; i<SEEDS; i++){
+        unsigned long g = once[i].generations;
+        unsigned b = 0;
+        while((g >= 4) && (b < 7)){
+            g >>= 2;
+            b++;
+        }
+        buckets[b]++;
+        total += once[i].generations;
+        lives[i].seed = i + 1;
+        lives[i].generations = once[i].generations;
+        lives[i].reset = once[i].reset;
+    }
+    printf("%lu still going after %lu generations, average %.0f generations\n",
+           (unsigned long)going, max_gens, total / SEEDS);
+    for(i=0; i<8; i++){
+        if(buckets[i]){
+            printf("  %5lu+ generations: %lu\n", i ? 1UL << (2*i) : 0UL,
+                   buckets[i]);
+        }
+    }
+
+    qsort(lives, SEEDS, sizeof(*lives), by_lifetime);
+    printf("longest lasting:\n");
+    for(i=0; i<best && i<SEEDS; i++){
+        printf("  seed 0x%04x: %lu generations%s\n",
+               lives[i].seed, lives[i].generations,
+               lives[i].reset ? "" : ", still going");
+    }
+    free(once);
+    free(chunked);
+    free(lives);
+    return 0;
+}
@@ -0,0 +1,219 @@
+//an ht1632c on the PC, at the level of its pins, see ht1632c_sim.h
+
+#include "ht1632c_sim.h"
+
+#include <stdlib.h>
+
+//the pins, as in ht1632c.c
+#define CS_BIT 3 //PORTB
+#define WR_BIT 4 //PORTB
+#define DATA_BIT 5 //PORTB
+#define RD_BIT 7 //PORTA
+
+//what the bits clocked in after CS went low are
+#define MODE_ID 0 //the 3 bit id, 1 0 0 command, 1 0 1 write, 1 1 0 read
+#define MODE_CMD 1 //commands, 8 bits and a dummy bit each
+#define MODE_ADDR 2 //the 7 bit address of a write or read
+#define MODE_WRITE 3 //data for the RAM
+#define MODE_READ 4 //data out of the RAM, on RD
+#define MODE_IGNORE 5 //an id the chip doesn't know, up to CS going high
+
+static uint8_t io[SIM_NB_IO];
+
+static uint8_t ram[64];
+static uint8_t written[64]; //bits of each nibble written since power on
+static unsigned long bits;
+static unsigned long lit_bits;
+static uint8_t lit, junk_shown;
+
+//the chip's side of a transaction
+static uint8_t cs=1, wr=1, rd=1; //levels last seen
+static uint8_t mode, id, count, shift, addr, nib_bit;
+static uint8_t data_out=1; //what the chip puts on DATA when reading
+static uint8_t driving; //1 while it does
+
+static uint8_t level(uint8_t port, uint8_t ddr, uint8_t bit){
+//a pin that isn't an output is pulled high
+    if(io[ddr] & (1<<bit))
+        return !!(io[port] & (1<<bit));
+    return 1;
+}
+
+static void command(uint8_t cmd){
+    switch(cmd){
+        case 0x00: //SYS DIS, the LEDs go off with the oscillator
+        case 0x02: //LED OFF
+            lit = 0;
+            lit_bits = 0;
+            break;
+        case 0x03: //LED ON
+            if(!lit){
+                uint8_t i;
+                for(i=0; i<64; i++){
+                    if(written[i] != 0x0f)
+                        junk_shown = 1;
+                }
+                lit = 1;
+                lit_bits = bits;
+            }
+            break;
+    }
+}
+
+static void next_nibble_bit(void){
+    if(++nib_bit == 4){
+        nib_bit = 0;
+        addr = (addr + 1) & 63;
+    }
+}
+
+static void clock_in(uint8_t bit){
+//WR has gone high with bit on DATA
+    bits++;
+    switch(mode){
+        case MODE_ID:
+            id = (id << 1) | bit;
+            if(++count == 3){
+                count = 0;
+                shift = 0;
+                if(id == 4)
+                    mode = MODE_CMD;
+                else if((id == 5) || (id == 6))
+                    mode = MODE_ADDR;
+                else
+                    mode = MODE_IGNORE;
+            }
+            break;
+        case MODE_CMD:
+            //the 9th bit is the dummy one, then the next command can follow
+            if(count < 8)
+                shift = (shift << 1) | bit;
+            if(++count == 8)
+                command(shift);
+            if(count == 9){
+                count = 0;
+                shift = 0;
+            }
+            break;
+        case MODE_ADDR:
+            shift = (shift << 1) | bit;
+            if(++count == 7){
+                addr = shift & 63;
+                nib_bit = 0;
+                mode = (id == 5) ? MODE_WRITE : MODE_READ;
+            }
+            break;
+        case MODE_WRITE:
+            if(bit)
+                ram[addr] |= 8 >> nib_bit;
+            else
+                ram[addr] &= ~(8 >> nib_bit);
+            written[addr] |= 8 >> nib_bit;
+            next_nibble_bit();
+            break;
+    }
+}
+
+static void clock_out(void){
+//RD has gone low, the next bit goes on DATA
+    if(mode != MODE_READ)
+        return;
+    bits++;
+    data_out = (ram[addr] >> (3 - nib_bit)) & 1;
+    driving = 1;
+    next_nibble_bit();
+}
+
+static void update(void){
+//passes on whatever has changed on the pins since it was last called
+    uint8_t ncs = level(SIM_PORTB, SIM_DDRB, CS_BIT);
+    uint8_t nwr = level(SIM_PORTB, SIM_DDRB, WR_BIT);
+    uint8_t nrd = level(SIM_PORTA, SIM_DDRA, RD_BIT);
+
+    if(cs && !ncs){
+        mode = MODE_ID;
+        id = 0;
+        count = 0;
+    }
+    if(!ncs){
+        if(!wr && nwr)
+            clock_in(level(SIM_PORTB, SIM_DDRB, DATA_BIT));
+        if(rd && !nrd)
+            clock_out();
+    }
+    if(!cs && ncs)
+        driving = 0;
+    cs = ncs;
+    wr = nwr;
+    rd = nrd;
+}
+
+static uint8_t pins(uint8_t port, uint8_t ddr){
+//what a PINx reads, with DATA the chip's when it's driving it
+    uint8_t val = io[port] | ~io[ddr];
+    if((port == SIM_PORTB) && driving && !(io[ddr] & (1<<DATA_BIT))){
+        val &= ~(1<<DATA_BIT);
+        val |= data_out << DATA_BIT;
+    }
+    return val;
+}
+
+volatile uint8_t *ht1632c_sim_io(uint8_t reg){
+    update();
+    if(reg == SIM_PINA)
+        io[reg] = pins(SIM_PORTA, SIM_DDRA);
+    else if(reg == SIM_PINB)
+        io[reg] = pins(SIM_PORTB, SIM_DDRB);
+    return &io[reg];
+}
+
+void ht1632c_sim_mcu_reset(void){
+    uint8_t i;
+    update();
+    for(i=0; i<SIM_NB_IO; i++)
+        io[i] = 0;
+    update();
+}
+
+void ht1632c_sim_reset(void){
+    uint8_t i;
+    ht1632c_sim_mcu_reset();
+    //real chips come up with junk in their RAM
+    for(i=0; i<64; i++){
+        ram[i] = rand() & 0x0f;
+        written[i] = 0;
+    }
+    bits = 0;
+    lit = 0;
+    lit_bits = 0;
+    junk_shown = 0;
+}
+
+unsigned long ht1632c_sim_bits(void){
+    update();
+    return bits;
+}
+
+void ht1632c_sim_bits_clear(void){
+    update();
+    bits = 0;
+}
+
+unsigned long ht1632c_sim_us(void){
+    return (ht1632c_sim_bits() * HT1632C_SIM_NS_PER_BIT) / 1000;
+}
+
+unsigned long ht1632c_sim_lit_bits(void){
+    update();
+    return lit_bits;
+}
+
+uint8_t ht1632c_sim_junk_shown(void){
+    update();
+    return junk_shown;
+}
+
+uint8_t ht1632c_sim_column(uint8_t x){
+    update();
+    return (ram[(x*2) & 63] << 4) | ram[(x*2 + 1) & 63];
+}
@@ -0,0 +1,59 @@
+//an ht1632c on the PC, at the level of its pins. the real ht1632c.c is
+//built against the headers in host/sim/, where PORTB and the rest go
+//through ht1632c_sim_io(), and this follows CS, WR, DATA and RD the way
+//the chip does: commands, writes and reads, with the address going up by
+//itself every 4 bits. it keeps the chip's RAM and counts the bits clocked,
+//so host programs can see what ends up on the display, how long it takes
+//to get it there, and whether the LEDs were ever on with the junk a chip
+//has in its RAM at power on still there.
+//
+//the pins are the ones in ht1632c.c: CS, WR and DATA on PB3-5, RD on PA7.
+//a pin that isn't an output is pulled high, like the ht1632c's own
+//pullups would.
+
+#ifndef HT1632C_SIM_H
+#define HT1632C_SIM_H
+
+#include <stdint.h>
+
+#include "ht1632c.h"
+
+//time for one bit through ht1632c_bits_mask() on the ATtiny26 at 8MHz,
+//about 10 cycles a bit when counted from the avr-gcc -Os listing
+#define HT1632C_SIM_NS_PER_BIT 1250UL
+
+//the registers host/sim/avr/io.h sends through ht1632c_sim_io()
+enum { SIM_PORTA, SIM_DDRA, SIM_PINA, SIM_PORTB, SIM_DDRB, SIM_PINB,
+       SIM_NB_IO };
+
+//the register for PORTA and so on. each time one is used, whatever was
+//done to the pins since the last time is passed on to the chip first, and
+//a PINx has what's on the pins then.
+volatile uint8_t *ht1632c_sim_io(uint8_t reg);
+
+//powers the board on: the chip's RAM gets junk, its LEDs are off, the
+//mcu's ports are all inputs, and the bits counted go back to 0
+void ht1632c_sim_reset(void);
+
+//resets only the mcu, like the watchdog does, the chip keeps going
+void ht1632c_sim_mcu_reset(void);
+
+//bits clocked on WR and RD since the last ht1632c_sim_reset() or
+//ht1632c_sim_bits_clear()
+unsigned long ht1632c_sim_bits(void);
+void ht1632c_sim_bits_clear(void);
+
+//how long the bits so far would have taken, in microseconds
+unsigned long ht1632c_sim_us(void);
+
+//what ht1632c_sim_bits() was when the LEDs were turned on, 0 if they're off
+unsigned long ht1632c_sim_lit_bits(void);
+
+//1 if the LEDs have been turned on with any of the RAM not yet written
+//since power on
+uint8_t ht1632c_sim_junk_shown(void);
+
+//reads column x back out of the RAM the way display.c writes it
+uint8_t ht1632c_sim_column(uint8_t x);
+
+#endif
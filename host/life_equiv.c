@@ -0,0 +1,348 @@
+//runs every Game of Life engine in life.c side by side on the same grids
+//and checks each generation against life_step_pixel(), the reference one:
+//the grid, the difference it returns and whether life_stagnant() wants a
+//reset. this is a host program, build and run it with `make equiv`.
+//built with LIFE_ENGINE_DISPLAY, the column engine keeps the grid in an
+//ht1632c's RAM instead of fb, through the real ht1632c.c driving the pin
+//level one in host/ht1632c_sim.c, reads and all.
+//built with LIFE_ASM and LIFE_ASM_SIM, the column engine's loop is
+//life_asm.S assembled by avr-gcc (LIFE_ASM_HEX, the Intel hex file of it)
+//and run in the AVR in host/avr_sim.c, which also checks it keeps to
+//avr-gcc's calling convention.
+//
+//usage: life_equiv [grids [generations [seed]]]
+//       life_equiv -f [generations]    keep fuzzing with new seeds forever
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "life.h"
+#if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+#include "host/ht1632c_sim.h"
+#endif
+#if LIFE_STEP_ASM
+#include "host/avr_sim.h"
+#endif
+
+//everything an engine keeps between generations
+struct life_state {
+    uint8_t grid[X_AXIS_LEN];
+    uint32_t changed;
+    struct life_stagnation stag;
+};
+
+struct engine {
+    const char *name;
+    uint8_t (*step)(void);
+};
+
+#if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+static uint8_t step_pixel_display(void);
+#endif
+
+//add new engines here, the first one is the reference
+static const struct engine engines[] = {
+#if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+    { "pixel", step_pixel_display },
+    { "display", life_step_column },
+#elif LIFE_STEP_ASM
+    { "pixel", life_step_pixel },
+    { "asm", life_step_column },
+#else
+    { "pixel", life_step_pixel },
+    { "column", life_step_column },
+#endif
+};
+#define NUM_ENGINES (sizeof(engines)/sizeof(engines[0]))
+
+//small patterns, columns from x=0, bit 0 is the top row
+static const uint8_t curated[][X_AXIS_LEN] = {
+    { 0 },                                  //empty
+    { 0x02, 0x04, 0x07 },                   //glider
+    { 0x02, 0x02, 0x02 },                   //blinker
+    { 0x03, 0x03 },                         //block
+    { 0x09, 0x10, 0x11, 0x1e },             //lightweight spaceship
+    { 0x02, 0x07, 0x01 },                   //r-pentomino
+    { [30] = 0x82, [31] = 0x04, [0] = 0x87 }, //glider across both wraps
+    { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }, //full
+};
+#define NUM_CURATED (sizeof(curated)/sizeof(curated[0]))
+
+static uint32_t rng;
+
+static uint32_t xorshift(void){
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static void random_grid(uint8_t *grid){
+    //a different density each time, from nearly empty to nearly full
+    uint8_t density = xorshift() & 7;
+    uint8_t x, y;
+    for(x=0;x<X_AXIS_LEN;x++){
+        grid[x] = 0;
+        for(y=0;y<Y_AXIS_LEN;y++){
+            if((xorshift() & 7) <= density){
+                grid[x] |= (1<<y);
+            }
+        }
+    }
+}
+
+#if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+//the same as main.c's, column x is at address x*2
+uint8_t life_col_read(uint8_t x){
+    return ht1632c_read8(x*2);
+}
+
+void life_col_write(uint8_t x, uint8_t col){
+    ht1632c_data8((x*2),col);
+}
+
+//the rest of life.c (life_stagnant() and so on) reads the grid through
+//LIFE_COL() too, so the reference engine's has to go in the ht1632c as well
+static uint8_t step_pixel_display(void){
+    uint8_t diff = life_step_pixel();
+    ht1632c_write_burst(0, fb, X_AXIS_LEN);
+    return diff;
+}
+#endif
+
+#if LIFE_STEP_ASM
+//where life_step_asm()'s arguments go in the AVR's RAM, the stack is
+//above them
+#define ASM_GRID AVR_SIM_RAM
+#define ASM_MASK (ASM_GRID + X_AXIS_LEN)
+#define ASM_MAX_CYCLES 10000UL //about 1000 for a whole grid
+
+static struct avr_sim avr;
+
+//the registers a function has to give back as it found them, and r1,
+//which has to be 0
+static uint8_t saved(uint8_t r){
+    return (r == 1) || ((r >= 2) && (r <= 17)) || (r == 28) || (r == 29);
+}
+
+uint8_t life_step_asm(uint8_t *grid, uint32_t *mask, uint16_t edges){
+//calls life_asm.S's with everything where avr-gcc would put it, and
+//junk in the registers it's allowed to use
+    uint8_t before[AVR_SIM_RAMEND + 1];
+    uint8_t sp, r, i;
+
+    memcpy(&avr.data[ASM_GRID], grid, X_AXIS_LEN);
+    for(i=0; i<4; i++){
+        avr.data[ASM_MASK + i] = (uint8_t)(*mask >> (i*8));
+    }
+    for(r=0; r<32; r++){
+        avr.data[r] = (uint8_t)rand();
+    }
+    avr.data[1] = 0;
+    avr.data[24] = ASM_GRID & 0xff;
+    avr.data[25] = ASM_GRID >> 8;
+    avr.data[22] = ASM_MASK & 0xff;
+    avr.data[23] = ASM_MASK >> 8;
+    avr.data[20] = edges & 0xff;
+    avr.data[21] = edges >> 8;
+    memcpy(before, avr.data, sizeof(before));
+    sp = AVR_SIM_SP(&avr);
+
+    if(avr_sim_call(&avr, 0, ASM_MAX_CYCLES)){
+        printf("life_asm.S: %s at %04x\n", avr.fault, avr.pc * 2);
+        exit(1);
+    }
+    for(r=0; r<32; r++){
+        if(saved(r) && (avr.data[r] != before[r])){
+            printf("life_asm.S: r%u was %02x and came back %02x\n",
+                   r, before[r], avr.data[r]);
+            exit(1);
+        }
+    }
+    if(AVR_SIM_SP(&avr) != sp){
+        printf("life_asm.S: SP was %02x and came back %02x\n",
+               sp, AVR_SIM_SP(&avr));
+        exit(1);
+    }
+    //only the grid and the mask, and what it pushed
+    for(i=ASM_MASK + 4; i<=AVR_SIM_RAMEND; i++){
+        if(((i <= avr.sp_min) || (i > sp)) && (avr.data[i] != before[i])){
+            printf("life_asm.S: wrote to %02x\n", i);
+            exit(1);
+        }
+    }
+
+    memcpy(grid, &avr.data[ASM_GRID], X_AXIS_LEN);
+    *mask = 0;
+    for(i=0; i<4; i++){
+        *mask |= (uint32_t)avr.data[ASM_MASK + i] << (i*8);
+    }
+    return avr.data[24];
+}
+#endif
+
+static void load(const struct life_state *s){
+    memcpy(fb, s->grid, X_AXIS_LEN);
+    #if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+    ht1632c_write_burst(0, s->grid, X_AXIS_LEN);
+    #endif
+    life_changed = s->changed;
+    life_stag = s->stag;
+}
+
+static void save(struct life_state *s){
+    #if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+    uint8_t x;
+    for(x=0;x<X_AXIS_LEN;x++){
+        s->grid[x] = ht1632c_sim_column(x);
+    }
+    #else
+    memcpy(s->grid, fb, X_AXIS_LEN);
+    #endif
+    s->changed = life_changed;
+    s->stag = life_stag;
+}
+
+static void print_grid(const uint8_t *grid){
+    uint8_t x, y;
+    for(y=0;y<Y_AXIS_LEN;y++){
+        for(x=0;x<X_AXIS_LEN;x++){
+            putchar((grid[x] & (1<<y)) ? '#' : '.');
+        }
+        putchar('\n');
+    }
+}
+
+//runs one starting grid through every engine, returns 0 if they agree
+static int check_grid(const uint8_t *start, unsigned long generations,
+                      unsigned long id){
+    struct life_state st[NUM_ENGINES];
+    uint8_t before[X_AXIS_LEN];
+    unsigned long g;
+    unsigned e;
+
+    life_stagnant_clear();
+    for(e=0;e<NUM_ENGINES;e++){
+        memcpy(st[e].grid, start, X_AXIS_LEN);
+        st[e].changed = 0xffffffff;
+        st[e].stag = life_stag;
+    }
+
+    for(g=0;g<generations;g++){
+        uint8_t ref_diff = 0, ref_reset = 0;
+        memcpy(before, st[0].grid, X_AXIS_LEN);
+
+        for(e=0;e<NUM_ENGINES;e++){
+            uint8_t diff, reset;
+            load(&st[e]);
+            diff = engines[e].step();
+            reset = life_stagnant(diff);
+            save(&st[e]);
+
+            if(e == 0){
+                ref_diff = diff;
+                ref_reset = reset;
+            } else if(memcmp(st[e].grid, st[0].grid, X_AXIS_LEN)
+                      || (diff != ref_diff) || (reset != ref_reset)){
+                printf("MISMATCH: %s vs %s, grid %lu, generation %lu\n",
+                       engines[e].name, engines[0].name, id, g);
+                printf("diff %u vs %u, reset %u vs %u\nfrom:\n",
+                       diff, ref_diff, reset, ref_reset);
+                print_grid(before);
+                printf("%s:\n", engines[0].name);
+                print_grid(st[0].grid);
+                printf("%s:\n", engines[e].name);
+                print_grid(st[e].grid);
+                return 1;
+            }
+        }
+
+        if(ref_reset){
+            //carry on from a new grid like the firmware would
+            uint8_t seed[X_AXIS_LEN];
+            random_grid(seed);
+            for(e=0;e<NUM_ENGINES;e++){
+                memcpy(st[e].grid, seed, X_AXIS_LEN);
+                st[e].changed = 0xffffffff;
+            }
+        }
+    }
+    return 0;
+}
+
+static int run(unsigned long grids, unsigned long generations){
+    uint8_t grid[X_AXIS_LEN];
+    unsigned long i;
+
+    for(i=0;i<NUM_CURATED;i++){
+        if(check_grid(curated[i], generations, i)){
+            return 1;
+        }
+    }
+    for(i=0;i<grids;i++){
+        random_grid(grid);
+        if(check_grid(grid, generations, NUM_CURATED + i)){
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv){
+    unsigned long grids = 20000;
+    unsigned long generations = 64;
+
+    #if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+    ht1632c_sim_reset();
+    ht1632c_init();
+    #endif
+    #if LIFE_STEP_ASM
+    if(avr_sim_load_hex(&avr, LIFE_ASM_HEX)){
+        return 1;
+    }
+    avr_sim_reset(&avr);
+    #endif
+
+    if((argc > 1) && !strcmp(argv[1], "-f")){
+        //fuzz until something breaks
+        unsigned long rounds = 0;
+        if(argc > 2) generations = strtoul(argv[2], NULL, 0);
+        for(;;){
+            uint32_t seed = (uint32_t)time(NULL) ^ (uint32_t)(rounds * 2654435761u);
+            rng = seed ? seed : 1;
+            if(run(1000, generations)){
+                printf("seed %lu\n", (unsigned long)seed);
+                return 1;
+            }
+            if(!(++rounds % 100)){
+                printf("%lu grids ok\n", rounds * 1000);
+                fflush(stdout);
+            }
+        }
+    }
+
+    rng = 1;
+    if(argc > 1) grids = strtoul(argv[1], NULL, 0);
+    if(argc > 2) generations = strtoul(argv[2], NULL, 0);
+    if(argc > 3) rng = strtoul(argv[3], NULL, 0);
+    if(!rng) rng = 1;
+
+    if(run(grids, generations)){
+        return 1;
+    }
+    {
+        unsigned e;
+        printf("%u engines (%s", (unsigned)NUM_ENGINES, engines[0].name);
+        for(e=1;e<NUM_ENGINES;e++){
+            printf(", %s", engines[e].name);
+        }
+    }
+    printf(") agree on %lu grids x %lu generations\n",
+           grids + NUM_CURATED, generations);
+    return 0;
+}
@@ -0,0 +1,87 @@
+//checks the seed prescreen in life.c against the real thing, and shows
+//how much it helps. every 16 bit seed is tried with life_prescreen() and
+//then also run with life_step() and life_stagnant() on fb, the way
+//main.c would show it. the prescreen has to call a seed good exactly when
+//the real run goes LIFE_PRESCREEN_GENS generations without a reset.
+//build and run it with `make prescreen`.
+//
+//usage: prescreen [generations]
+//  how long a grid may run for before it's counted as lasting, default 2000
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "life.h"
+
+#if !LIFE_PRESCREEN
+#error "build this with -DLIFE_PRESCREEN=1"
+#endif
+
+static unsigned long lifetime(uint16_t seed, unsigned long max_gens){
+//how many generations seed runs on fb before the one where
+//life_stagnant() resets it
+    unsigned long gen;
+    uint8_t x;
+
+    for(x=0; x<X_AXIS_LEN; x++){
+        seed = life_seed_next(seed);
+        fb[x] = (uint8_t)seed;
+    }
+    life_all_changed();
+    life_stagnant_clear();
+
+    for(gen=1; gen<=max_gens; gen++){
+        if(life_stagnant(life_step())){
+            return gen - 1;
+        }
+    }
+    return max_gens;
+}
+
+int main(int argc, char **argv){
+    unsigned long max_gens = 2000;
+    unsigned long seeds=0, good=0;
+    unsigned long doa=0; //reset within LIFE_PRESCREEN_GENS
+    double life_all=0, life_good=0;
+    uint8_t verdict;
+    uint16_t seed=1;
+
+    if(argc > 1){
+        max_gens = strtoul(argv[1], NULL, 0);
+    }
+    if(max_gens < LIFE_PRESCREEN_GENS){
+        max_gens = LIFE_PRESCREEN_GENS;
+    }
+
+    do{
+        unsigned long gens;
+
+        life_prescreen_start(seed);
+        while((verdict = life_prescreen()) == LIFE_SEED_TRYING){
+        }
+        gens = lifetime(seed, max_gens);
+
+        if((verdict == LIFE_SEED_GOOD) != (gens >= LIFE_PRESCREEN_GENS)){
+            printf("MISMATCH: seed %u, prescreen says %s, lasted %lu generations\n",
+                   seed, (verdict == LIFE_SEED_GOOD) ? "good" : "bad", gens);
+            return 1;
+        }
+
+        seeds++;
+        life_all += gens;
+        if(gens < LIFE_PRESCREEN_GENS){
+            doa++;
+        }
+        if(verdict == LIFE_SEED_GOOD){
+            good++;
+            life_good += gens;
+        }
+    }while(++seed != 0);
+
+    printf("prescreen agrees with the engine on %lu seeds\n", seeds);
+    printf("%lu of them (%.1f%%) reset within %u generations, %lu pass\n",
+           doa, 100.0 * doa / seeds, LIFE_PRESCREEN_GENS, good);
+    printf("average generations before a reset (up to %lu): %.0f random, %.0f prescreened\n",
+           max_gens, life_all / seeds, good ? life_good / good : 0.0);
+    return 0;
+}
@@ -0,0 +1,120 @@
+//prints the run log out of a dump of the board's EEPROM (see runlog.h),
+//oldest record first, and then how long grids lasted for each reason
+//they were reset. get the dump with something like
+//`avrdude -p t26 -c usbasp -U eeprom:r:eeprom.bin:r`.
+//build it with `make runlog_dump`.
+//
+//usage: runlog_dump [eeprom.bin]
+//  reads stdin if there's no file
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "runlog.h"
+
+//the RESET_EV_... bits from main.c, in order
+static const char *const reasons[] = {
+    "stagnant", "button", "gen limit", "watchdog", "power on", "wall",
+};
+#define NB_REASONS (sizeof(reasons) / sizeof(reasons[0]))
+#define STARTED_UP ((1 << 3) | (1 << 4)) //watchdog, power on
+
+static uint8_t image[RUNLOG_SIZE];
+
+uint8_t runlog_read(uint8_t addr){
+    return image[addr];
+}
+
+//the log is only read here
+uint8_t runlog_ready(void){
+    return 1;
+}
+
+void runlog_write(uint8_t addr, uint8_t b){
+    (void)addr;
+    (void)b;
+}
+
+static unsigned get16(uint8_t slot, uint8_t at){
+    return image[slot * RUNLOG_REC + at] | (image[slot * RUNLOG_REC + at + 1] << 8);
+}
+
+static void print_reason(uint8_t reason){
+    unsigned i;
+    const char *sep = "";
+    
+    for(i=0; i<8; i++){
+        if(reason & (1 << i)){
+            if(i < NB_REASONS){
+                printf("%s%s", sep, reasons[i]);
+            } else {
+                printf("%sbit %u", sep, i);
+            }
+            sep = ", ";
+        }
+    }
+}
+
+int main(int argc, char **argv){
+    FILE *f = stdin;
+    uint8_t newest, slot, n;
+    unsigned long count[NB_REASONS] = {0}, gens[NB_REASONS] = {0};
+    unsigned i, records = 0;
+    
+    if(argc > 1 && !(f = fopen(argv[1], "rb"))){
+        perror(argv[1]);
+        return 1;
+    }
+    if(fread(image, 1, RUNLOG_SIZE, f) != RUNLOG_SIZE){
+        fprintf(stderr, "need %u bytes of EEPROM\n", RUNLOG_SIZE);
+        return 1;
+    }
+    
+    newest = runlog_newest();
+    if(newest == RUNLOG_SLOTS){
+        printf("nothing logged\n");
+        return 0;
+    }
+    
+    printf(" seq boot  gens  seed  reason\n");
+    for(n=1; n<=RUNLOG_SLOTS; n++){
+        uint8_t reason;
+        
+        slot = (newest + n) % RUNLOG_SLOTS;
+        if(!runlog_valid(slot)){
+            continue; //never written, or cut off
+        }
+        reason = image[slot * RUNLOG_REC + RL_REASON];
+        printf("%4u %4u ", image[slot * RUNLOG_REC + RL_SEQ],
+               image[slot * RUNLOG_REC + RL_BOOT]);
+        for(i=0; i<NB_REASONS; i++){
+            if(reason & (1 << i)){
+                count[i]++;
+                gens[i] += get16(slot, RL_GENS);
+            }
+        }
+        if(reason & ~STARTED_UP){
+            //a grid that was reset
+            printf("%5u %5u  ", get16(slot, RL_GENS), get16(slot, RL_SEED));
+        } else {
+            printf("    -     -  started up, ");
+        }
+        print_reason(reason);
+        printf("\n");
+        records++;
+    }
+    
+    printf("\n%u records\n", records);
+    for(i=0; i<NB_REASONS; i++){
+        if(!count[i]){
+            continue;
+        }
+        if((1 << i) & STARTED_UP){
+            printf("%-9s %3lu start ups\n", reasons[i], count[i]);
+        } else {
+            printf("%-9s %3lu grids, lasting %lu generations on average\n",
+                   reasons[i], count[i], gens[i] / count[i]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+//checks the run log in runlog.c against an EEPROM kept in an array, with
+//the power going off at random, often part way through a record. after
+//every start up the newest record has to be the last one that was
+//written all the way, and the records before it have to be the ones
+//before that. it also counts the writes to each byte of the EEPROM, like
+//eeprom_update_byte() only those that change it, to show how long the
+//EEPROM will last. when a grid ends before the last record is written,
+//runlog_add() merges the two, so it also checks no generations go missing
+//when the power stays on. build and run it with `make runlog_sim`.
+//
+//usage: runlog_sim [start ups [eeprom.bin]]
+//  also writes the EEPROM out at the end, to try runlog_dump on
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "runlog.h"
+
+#define MAX_DONE 100000UL
+
+static uint8_t eeprom[RUNLOG_SIZE];
+static unsigned long wear[RUNLOG_SIZE];
+static long power_left; //writes until the power goes, -1 for never
+
+static uint8_t done[MAX_DONE][RUNLOG_REC]; //records written all the way
+static unsigned long nb_done;
+static unsigned long torn, torn_ok; //records cut off, and those that
+                                    //still checked out
+
+uint8_t runlog_read(uint8_t addr){
+    return eeprom[addr];
+}
+
+uint8_t runlog_ready(void){
+    return 1;
+}
+
+void runlog_write(uint8_t addr, uint8_t b){
+    if(power_left == 0){
+        return;
+    }
+    if(power_left > 0){
+        power_left--;
+    }
+    if(eeprom[addr] != b){
+        eeprom[addr] = b;
+        wear[addr]++;
+    }
+    if((addr % RUNLOG_REC) == RUNLOG_REC - 1 && nb_done < MAX_DONE){
+        memcpy(done[nb_done++], &eeprom[addr - (RUNLOG_REC - 1)], RUNLOG_REC);
+    }
+}
+
+static void finish(void){
+    unsigned i;
+    for(i=0; i<RUNLOG_REC; i++){
+        runlog_service();
+    }
+}
+
+static int check(unsigned long boot){
+//walks back from the newest record, which has to match the last ones done
+    uint8_t slot = runlog_newest(), n;
+    unsigned long d = nb_done;
+    
+    if(!nb_done){
+        return slot == RUNLOG_SLOTS;
+    }
+    if(slot == RUNLOG_SLOTS){
+        printf("MISMATCH: start up %lu, nothing found\n", boot);
+        return 0;
+    }
+    if(memcmp(&eeprom[slot * RUNLOG_REC], done[d-1], RUNLOG_REC)){
+        //a cut off record that adds up anyway. it does look like the
+        //newest, with its new RL_SEQ, and the log carries on after it,
+        //so from here on it's one of the records.
+        torn_ok++;
+        memcpy(done[nb_done++], &eeprom[slot * RUNLOG_REC], RUNLOG_REC);
+        d = nb_done;
+    }
+    for(n=0; n<RUNLOG_SLOTS - 1 && d; n++, d--){
+        const uint8_t *r = &eeprom[slot * RUNLOG_REC];
+        if(!runlog_valid(slot)){
+            break; //cut off, the ones before it have been written over
+        }
+        if(memcmp(r, done[d-1], RUNLOG_REC)){
+            printf("MISMATCH: start up %lu, %u records back, seq %u vs %u\n",
+                   boot, n, r[RL_SEQ], done[d-1][RL_SEQ]);
+            return 0;
+        }
+        slot = (slot + RUNLOG_SLOTS - 1) % RUNLOG_SLOTS;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv){
+    unsigned long boots = 5000, b, grids = 0, most = 0, merged = 0;
+    unsigned i;
+    
+    if(argc > 1){
+        boots = strtoul(argv[1], NULL, 0);
+    }
+    srand(1);
+    memset(eeprom, 0xff, sizeof(eeprom)); //as it comes
+    
+    for(b=0; b<boots && nb_done < MAX_DONE - 64; b++){
+        int n = rand() % 40;
+        unsigned long from, added, grids_before = grids;
+        
+        //half the time the power goes part way through writing something
+        power_left = (rand() & 1) ? (long)(rand() % ((n + 1) * RUNLOG_REC)) : -1;
+        
+        if(!check(b)){
+            return 1;
+        }
+        runlog_start((rand() % 4) ? (1 << 4) : (1 << 3));
+        finish();
+        from = nb_done;
+        added = 0;
+        while(n--){
+            uint16_t gens = rand() % 2000;
+            runlog_add(1 << (rand() % 3), gens, rand());
+            added += gens;
+            grids++;
+            //sometimes the next one comes before this one is done
+            if(rand() % 8){
+                finish();
+            }
+        }
+        finish();
+        if(power_left == 0){
+            torn++;
+        } else {
+            //everything added is in the records this time round
+            unsigned long logged = 0, d;
+            for(d=from; d<nb_done; d++){
+                logged += done[d][RL_GENS] | (done[d][RL_GENS+1] << 8);
+            }
+            if(logged != added){
+                printf("MISMATCH: start up %lu, %lu generations added, "
+                       "%lu logged\n", b, added, logged);
+                return 1;
+            }
+            merged += (grids - grids_before) - (nb_done - from);
+        }
+    }
+    
+    for(i=0; i<RUNLOG_SIZE; i++){
+        if(wear[i] > most){
+            most = wear[i];
+        }
+    }
+    printf("%lu start ups, %lu grids, %lu records written, "
+           "%lu cut off (%lu of those still added up)\n",
+           b, grids, nb_done, torn, torn_ok);
+    printf("the newest record was always the last one written (or cut off and added up)\n");
+    printf("%lu grids ended before the last record was written and were "
+           "merged into it, without losing any generations\n", merged);
+    printf("most writes to one byte: %lu, one for every %.1f records\n",
+           most, (double)nb_done / most);
+    printf("at a reset every 2 minutes, 100000 writes a byte lasts %.1f years\n",
+           100000.0 * nb_done / most * 2 / 60 / 24 / 365);
+    
+    if(argc > 2){
+        FILE *f = fopen(argv[2], "wb");
+        if(!f || fwrite(eeprom, 1, RUNLOG_SIZE, f) != RUNLOG_SIZE){
+            perror(argv[2]);
+            return 1;
+        }
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,175 @@
+//runs sched.c on the PC against a made up timer1, with tasks like the
+//ones in main.c's table taking made up amounts of time, some of them
+//long enough to hold the others up for a tick or two. checks that:
+//
+//  every task with a period is run once per period, none are lost even
+//  when it gets behind, and it's never run before it's due
+//  the generation (sched_delay()) goes at exactly its speed
+//  the first run of each is a period after the start, like the plain loop
+//  the run count and worst case kept for each slot are right
+//  no task is ever kept waiting longer than all the others' worst cases
+//  added up, which is what the scheduler promises
+//
+//build and run it with `make sched_sim`.
+//
+//usage: sched_sim [ticks]
+//  how many timer1 overflows to run for, default 1000000 (about 2 hours)
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sched.h"
+
+#define GEN_TICKS 64
+
+static unsigned long now; //in sched_time() steps, 256 a tick
+static unsigned long ticks; //sched_ticks, without wrapping
+
+uint16_t sched_time(void){
+    return (uint16_t)now;
+}
+
+static void spend(unsigned long steps){
+//time goes by while a task runs, with timer1 overflowing as it does
+    now += steps;
+    while((now >> 8) > ticks){
+        ticks++;
+        sched_ticks++; //what the ISR does
+    }
+}
+
+static unsigned long between(unsigned long min, unsigned long max){
+    return min + (unsigned long)rand() % (max - min + 1);
+}
+
+//what's known about each task, in the same order as tasks[]
+struct model {
+    const char *name;
+    unsigned long due; //tick it should be run at next
+    unsigned long runs;
+    unsigned long longest; //steps it has really taken
+    unsigned long late; //longest it has been kept waiting, in steps
+    unsigned long early; //times it was run before it was due
+};
+
+enum { BUTTON, GENERATION, REFRESH, BRIGHTNESS, SERVICE, NB_TASKS };
+static struct model model[NB_TASKS] = {
+    { "button" }, { "generation" }, { "refresh" }, { "brightness" },
+    { "service" },
+};
+
+static void ran(int i, unsigned long period, unsigned long steps){
+//a task has been started, with the period it's due by
+    struct model *m = &model[i];
+
+    if(period){
+        if(ticks < m->due){
+            m->early++;
+        } else if(now - (m->due << 8) > m->late){
+            m->late = now - (m->due << 8);
+        }
+        m->due += period;
+    }
+    m->runs++;
+    if(steps > m->longest){
+        m->longest = steps;
+    }
+    spend(steps);
+}
+
+static void task_button(void){
+    ran(BUTTON, 1, between(1, 3));
+}
+
+static void task_generation(void){
+    unsigned long steps = between(40, 160); //1.3-5.1ms
+    if(!(rand() % 50)){
+        steps = between(256, 700); //one that holds everything up
+    }
+    sched_delay(GEN_TICKS);
+    ran(GENERATION, GEN_TICKS, steps);
+}
+
+static void task_refresh(void){
+    ran(REFRESH, 0, 2);
+}
+
+static void task_brightness(void){
+    ran(BRIGHTNESS, GEN_TICKS, between(4, 6));
+}
+
+static void task_service(void){
+    ran(SERVICE, 0, between(0, 1));
+}
+
+static const struct sched_task tasks[NB_TASKS] = {
+    { task_button, 1 },
+    { task_generation, GEN_TICKS },
+    { task_refresh, 0 },
+    { task_brightness, GEN_TICKS },
+    { task_service, 0 },
+};
+static struct sched_slot slots[NB_TASKS];
+
+int main(int argc, char **argv){
+    unsigned long max_ticks = 1000000, bound = 0, loops = 0;
+    int i, bad = 0;
+
+    if(argc > 1){
+        max_ticks = strtoul(argv[1], NULL, 0);
+    }
+    srand(1);
+
+    for(i=0; i<NB_TASKS; i++){
+        model[i].due = tasks[i].period; //sched_start() is at tick 0
+    }
+    sched_start(tasks, slots, NB_TASKS);
+    while(ticks < max_ticks){
+        sched_run(tasks, slots, NB_TASKS);
+        loops++;
+    }
+
+    for(i=0; i<NB_TASKS; i++){
+        bound += model[i].longest;
+    }
+    printf("%lu ticks, %lu times round the loop\n", ticks, loops);
+    printf("task        period     runs  worst   kept waiting\n");
+    for(i=0; i<NB_TASKS; i++){
+        struct model *m = &model[i];
+        uint8_t period = tasks[i].period;
+
+        if(i == GENERATION){
+            period = GEN_TICKS;
+        }
+        printf("%-10s  %6u %8lu %6uus %6luus\n", m->name, period,
+               m->runs, slots[i].worst * SCHED_TIME_US,
+               m->late * SCHED_TIME_US);
+        if((uint16_t)m->runs != slots[i].runs){
+            printf("MISMATCH: %s run %lu times, counted %u\n", m->name,
+                   m->runs, slots[i].runs);
+            bad = 1;
+        }
+        if(m->longest != slots[i].worst){
+            printf("MISMATCH: %s took up to %lu, worst kept is %u\n", m->name,
+                   m->longest, slots[i].worst);
+            bad = 1;
+        }
+        if(m->early){
+            printf("MISMATCH: %s run before it was due %lu times\n", m->name,
+                   m->early);
+            bad = 1;
+        }
+        if(period && (m->due + period < ticks)){
+            printf("MISMATCH: %s got %lu ticks behind\n", m->name,
+                   ticks - m->due);
+            bad = 1;
+        }
+        if(m->late > bound){
+            printf("MISMATCH: %s waited %luus, more than all the worst cases\n",
+                   m->name, m->late * SCHED_TIME_US);
+            bad = 1;
+        }
+    }
+    printf("all the worst cases added up: %luus\n", bound * SCHED_TIME_US);
+    return bad;
+}
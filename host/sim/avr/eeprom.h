@@ -0,0 +1,20 @@
+//avr-libc's <avr/eeprom.h> for the PC, the EEPROM is an array in
+//host/sim/regs.c and is always ready
+
+#ifndef HOST_SIM_AVR_EEPROM_H
+#define HOST_SIM_AVR_EEPROM_H
+
+#include <stdint.h>
+
+#define E2END 127
+#define EEMEM
+
+extern uint8_t sim_eeprom[E2END + 1];
+
+#define eeprom_is_ready() 1
+#define eeprom_busy_wait() do { } while(0)
+#define eeprom_read_byte(addr) (sim_eeprom[(uintptr_t)(addr) & E2END])
+#define eeprom_write_byte(addr, val) (sim_eeprom[(uintptr_t)(addr) & E2END] = (val))
+#define eeprom_update_byte(addr, val) eeprom_write_byte(addr, val)
+
+#endif
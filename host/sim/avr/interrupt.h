@@ -0,0 +1,19 @@
+//avr-libc's <avr/interrupt.h> for the PC, see host/sim/avr/io.h.
+//nothing interrupts on the PC, the ISRs are plain functions that the
+//program running the firmware can call itself.
+
+#ifndef HOST_SIM_AVR_INTERRUPT_H
+#define HOST_SIM_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+#define ISR(vector) void vector(void)
+
+#define cli() (SREG &= ~0x80)
+#define sei() (SREG |= 0x80, sim_sei())
+
+//called when the firmware turns interrupts on, the program running it
+//has to provide this
+void sim_sei(void);
+
+#endif
@@ -0,0 +1,92 @@
+//just enough of avr-libc's <avr/io.h> to build the firmware's sources on
+//the PC, see host/ht1632c_sim.h. the ports go through ht1632c_sim_io(),
+//so the simulated ht1632c sees every change to its pins in the order the
+//code makes them. the rest of the registers are plain variables, in
+//host/sim/regs.c, with the ATtiny26's bit names.
+
+#ifndef HOST_SIM_AVR_IO_H
+#define HOST_SIM_AVR_IO_H
+
+#include <stdint.h>
+
+#include "host/ht1632c_sim.h"
+
+#define PORTA (*ht1632c_sim_io(SIM_PORTA))
+#define DDRA (*ht1632c_sim_io(SIM_DDRA))
+#define PINA (*ht1632c_sim_io(SIM_PINA))
+#define PORTB (*ht1632c_sim_io(SIM_PORTB))
+#define DDRB (*ht1632c_sim_io(SIM_DDRB))
+#define PINB (*ht1632c_sim_io(SIM_PINB))
+
+extern volatile uint8_t SREG, MCUSR, MCUCR, GIMSK, GIFR, TIMSK, TIFR;
+extern volatile uint8_t TCCR0, TCNT0, TCCR1A, TCCR1B, TCNT1;
+extern volatile uint8_t OCR1A, OCR1B, OCR1C, PLLCSR, WDTCR;
+extern volatile uint8_t ADMUX, ADCSR, ADCL, ADCH;
+extern volatile uint16_t ADC;
+extern volatile uint8_t EEAR, EEDR, EECR;
+extern volatile uint8_t USIDR, USISR, USICR;
+
+//MCUSR
+#define WDRF 3
+#define BORF 2
+#define EXTRF 1
+#define PORF 0
+
+//GIMSK, GIFR, MCUCR
+#define INT0 6
+#define INTF0 6
+#define ISC01 1
+#define ISC00 0
+
+//TIMSK, TIFR
+#define OCIE1A 6
+#define TOIE1 2
+#define TOV1 2
+#define TOIE0 1
+#define TOV0 1
+
+//TCCR0, TCCR1B
+#define CS02 2
+#define CS01 1
+#define CS00 0
+#define CTC1 7
+#define CS13 3
+#define CS12 2
+#define CS11 1
+#define CS10 0
+
+//ADCSR
+#define ADEN 7
+#define ADSC 6
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+
+//EECR
+#define EERIE 3
+#define EEMWE 2
+#define EEWE 1
+#define EERE 0
+
+//USISR, USICR
+#define USISIF 7
+#define USIOIF 6
+#define USIOIE 6
+#define USIWM0 4
+#define USICS1 3
+
+//WDTCR
+#define WDCE 4
+#define WDE 3
+
+#define RAMEND 0xDF
+
+#define _BV(bit) (1 << (bit))
+#define bit_is_set(sfr, bit) ((sfr) & _BV(bit))
+#define bit_is_clear(sfr, bit) (!((sfr) & _BV(bit)))
+//there's nothing to wait for on the PC, whatever was started (like an ADC
+//conversion) is done straight away
+#define loop_until_bit_is_set(sfr, bit) do { (sfr) |= _BV(bit); } while(0)
+#define loop_until_bit_is_clear(sfr, bit) do { (sfr) &= ~_BV(bit); } while(0)
+
+#endif
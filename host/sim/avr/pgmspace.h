@@ -0,0 +1,12 @@
+//avr-libc's <avr/pgmspace.h> for the PC, flash is the same as RAM there
+
+#ifndef HOST_SIM_AVR_PGMSPACE_H
+#define HOST_SIM_AVR_PGMSPACE_H
+
+#include <stdint.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+
+#endif
@@ -0,0 +1,20 @@
+//avr-libc's <avr/wdt.h> for the PC, there's no watchdog to go off there.
+//a program that wants one sets WDRF in MCUSR and starts the firmware again.
+
+#ifndef HOST_SIM_AVR_WDT_H
+#define HOST_SIM_AVR_WDT_H
+
+#define WDTO_15MS 0
+#define WDTO_30MS 1
+#define WDTO_60MS 2
+#define WDTO_120MS 3
+#define WDTO_250MS 4
+#define WDTO_500MS 5
+#define WDTO_1S 6
+#define WDTO_2S 7
+
+#define wdt_enable(timeout) ((void)(timeout))
+#define wdt_reset() do { } while(0)
+#define wdt_disable() do { } while(0)
+
+#endif
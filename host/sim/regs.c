@@ -0,0 +1,15 @@
+//the registers from host/sim/avr/io.h that aren't on the ht1632c's pins,
+//as they are after a reset
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+
+volatile uint8_t SREG, MCUSR, MCUCR, GIMSK, GIFR, TIMSK, TIFR;
+volatile uint8_t TCCR0, TCNT0, TCCR1A, TCCR1B, TCNT1;
+volatile uint8_t OCR1A, OCR1B, OCR1C, PLLCSR, WDTCR;
+volatile uint8_t ADMUX, ADCSR, ADCL, ADCH;
+volatile uint16_t ADC;
+volatile uint8_t EEAR, EEDR, EECR;
+volatile uint8_t USIDR, USISR, USICR;
+
+uint8_t sim_eeprom[E2END + 1];
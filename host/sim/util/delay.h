@@ -0,0 +1,9 @@
+//avr-libc's <util/delay.h> for the PC, where the delays are left out
+
+#ifndef HOST_SIM_UTIL_DELAY_H
+#define HOST_SIM_UTIL_DELAY_H
+
+#define _delay_ms(ms) ((void)(ms))
+#define _delay_us(us) ((void)(us))
+
+#endif
@@ -0,0 +1,282 @@
+//runs a variant's firmware, the .hex avr-gcc made, in the ATtiny26 core in
+//host/avr_sim.c for a while and checks how deep the stack really got:
+//
+//  it never came within STACK_MIN_FREE bytes of the variables
+//  it never needed more than the STACK_MIN that `make sizes` allows for
+//  the free RAM the firmware painted at start up (stack_check.c) is
+//  still painted below the deepest the stack got, so nothing else wrote
+//  there and the firmware's own stack_used() sees the same as the core
+//
+//the core only has the peripherals the firmware uses, just enough of them:
+//timer0 and timer1 counting and overflowing, the ADC finishing as soon as
+//it's started, the EEPROM writing straight away, and a USI byte coming in
+//every so often for the stream variant. the ports go to the pin level
+//ht1632c in host/ht1632c_sim.c, and the button on PB6 gets pressed now and
+//then, short, long and double, so its code runs under the timer ISR too.
+//`make stack_sim` runs it for every variant.
+//
+//usage: stack_sim hex ram [stack_min [seconds [lit]]]
+//  ram is the bytes of .data, .bss and .noinit, stack_min is STACK_MIN
+//  from the Makefile (default 42), seconds is how long to run (default 30).
+//  lit 0 is for the other display backends: the core's ht1632c can't tell
+//  if they came on, just that something was clocked out on its pins
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "avr_sim.h"
+#include "ht1632c_sim.h"
+
+#define F_CPU 8000000UL
+#define STACK_MIN_FREE 4 //as in main.c
+#define STACK_PAINT 0xc5 //as in stack_check.h
+
+//the ATtiny26's I/O registers, as IN and OUT address them
+#define PINB 0x16
+#define DDRB 0x17
+#define PORTB 0x18
+#define PINA 0x19
+#define DDRA 0x1a
+#define PORTA 0x1b
+#define EECR 0x1c
+#define EEDR 0x1d
+#define EEAR 0x1e
+#define USICR 0x0d
+#define USISR 0x0e
+#define USIDR 0x0f
+#define ADCL 0x04
+#define ADCH 0x05
+#define ADCSR 0x06
+#define TCNT1 0x2e
+#define TCCR1B 0x2f
+#define TCNT0 0x32
+#define TCCR0 0x33
+#define TIFR 0x38
+#define TIMSK 0x39
+
+//bits in them
+#define EERE 0
+#define EEWE 1
+#define USIOIF 6
+#define USIOIE 6
+#define ADIF 4
+#define ADSC 6
+#define TOV0 1
+#define TOV1 2
+#define BUTTON_BIT 6
+
+//interrupt vectors
+#define TIMER1_OVF1_vect 5
+#define TIMER0_OVF0_vect 6
+#define USI_OVF_vect 8
+
+#define US(us) ((unsigned long)(us) * (F_CPU / 1000000UL))
+#define MS(ms) (US(ms) * 1000UL)
+
+static struct avr_sim avr;
+static uint8_t eeprom[128];
+static uint8_t button_down;
+static unsigned long t0_cycles, t1_cycles;
+
+static uint8_t *sim_pin(uint8_t addr){
+//the ports, or 0 for the rest
+    switch(addr){
+        case PINA: return (uint8_t *)ht1632c_sim_io(SIM_PINA);
+        case DDRA: return (uint8_t *)ht1632c_sim_io(SIM_DDRA);
+        case PORTA: return (uint8_t *)ht1632c_sim_io(SIM_PORTA);
+        case PINB: return (uint8_t *)ht1632c_sim_io(SIM_PINB);
+        case DDRB: return (uint8_t *)ht1632c_sim_io(SIM_DDRB);
+        case PORTB: return (uint8_t *)ht1632c_sim_io(SIM_PORTB);
+    }
+    return 0;
+}
+
+static uint8_t io_read(struct avr_sim *a, uint8_t addr){
+    uint8_t *pin = sim_pin(addr);
+
+    if(pin){
+        if((addr == PINB) && button_down){
+            return *pin & ~(1<<BUTTON_BIT);
+        }
+        return *pin;
+    }
+    return a->data[AVR_SIM_IO + addr];
+}
+
+static void io_write(struct avr_sim *a, uint8_t addr, uint8_t val){
+    uint8_t *reg = &a->data[AVR_SIM_IO + addr];
+    uint8_t *pin = sim_pin(addr);
+
+    if(pin){
+        if((addr != PINA) && (addr != PINB)){
+            *pin = val;
+        }
+        return;
+    }
+    switch(addr){
+        case TIFR:
+            *reg &= ~val; //the flags are cleared by writing 1s
+            return;
+        case USISR:
+            *reg = (*reg & ~(val & (1<<USIOIF))) | (val & ~(1<<USIOIF));
+            return;
+        case ADCSR:
+            //the conversion is done straight away, with some noise
+            *reg = val & ~(1<<ADIF);
+            if(val & (1<<ADSC)){
+                uint16_t adc = rand() & 0x3ff;
+                a->data[AVR_SIM_IO + ADCL] = adc & 0xff;
+                a->data[AVR_SIM_IO + ADCH] = adc >> 8;
+                *reg = (*reg & ~(1<<ADSC)) | (1<<ADIF);
+            }
+            if(val & (1<<ADIF)){
+                *reg &= ~(1<<ADIF);
+            }
+            return;
+        case EECR:
+            if(val & (1<<EERE)){
+                a->data[AVR_SIM_IO + EEDR] = eeprom[a->data[AVR_SIM_IO + EEAR] & 127];
+            }
+            if(val & (1<<EEWE)){
+                eeprom[a->data[AVR_SIM_IO + EEAR] & 127] = a->data[AVR_SIM_IO + EEDR];
+            }
+            *reg = val & ~((1<<EERE) | (1<<EEWE));
+            return;
+    }
+    *reg = val;
+}
+
+#define IO(addr) (avr.data[AVR_SIM_IO + (addr)])
+
+static void timers(unsigned long cycles){
+    //timer1 prescaler, CK/2^(n-1) for the CS1x bits n
+    uint8_t cs1 = IO(TCCR1B) & 0x0f;
+    //timer0's: off, CK, CK/8, CK/64, CK/256, CK/1024
+    static const unsigned long div0[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+    unsigned long d0 = div0[IO(TCCR0) & 7];
+
+    if(cs1){
+        unsigned long d1 = 1UL << (cs1 - 1);
+        t1_cycles += cycles;
+        while(t1_cycles >= d1){
+            t1_cycles -= d1;
+            if(!++IO(TCNT1)){
+                IO(TIFR) |= (1<<TOV1);
+            }
+        }
+    }
+    if(d0){
+        t0_cycles += cycles;
+        while(t0_cycles >= d0){
+            t0_cycles -= d0;
+            if(!++IO(TCNT0)){
+                IO(TIFR) |= (1<<TOV0);
+            }
+        }
+    }
+}
+
+static void interrupts(void){
+//the one with the lowest vector goes first, the flag is cleared as the
+//chip would when it's taken
+    if((IO(TIFR) & IO(TIMSK) & (1<<TOV1))
+       && avr_sim_irq(&avr, TIMER1_OVF1_vect)){
+        IO(TIFR) &= ~(1<<TOV1);
+    } else if((IO(TIFR) & IO(TIMSK) & (1<<TOV0))
+              && avr_sim_irq(&avr, TIMER0_OVF0_vect)){
+        IO(TIFR) &= ~(1<<TOV0);
+    } else if((IO(USISR) & IO(USICR) & (1<<USIOIE))){
+        //the firmware clears USIOIF itself
+        avr_sim_irq(&avr, USI_OVF_vect);
+    }
+}
+
+static void outside(unsigned long now){
+//the button and the stream, on a cycle of 3 seconds: a short press, a
+//double press, then a long press, and a byte on the USI every 500us
+    static unsigned long next_byte;
+    unsigned long t = now % MS(3000);
+
+    button_down = (t < MS(100))
+                  || ((t >= MS(1000)) && (t < MS(1080)))
+                  || ((t >= MS(1200)) && (t < MS(1280)))
+                  || ((t >= MS(2000)) && (t < MS(2900)));
+    if(IO(USICR) && (now >= next_byte)){
+        IO(USIDR) = (uint8_t)rand();
+        IO(USISR) |= (1<<USIOIF);
+        next_byte = now + US(500);
+    }
+}
+
+int main(int argc, char **argv){
+    unsigned long seconds = 30, end;
+    unsigned ram, stack_min = 42, lit = 1;
+    unsigned ram_end, free_core, free_painted, used;
+    int bad = 0;
+
+    if(argc < 3){
+        printf("usage: stack_sim hex ram [stack_min [seconds [lit]]]\n");
+        return 1;
+    }
+    ram = strtoul(argv[2], NULL, 0);
+    if(argc > 3) stack_min = strtoul(argv[3], NULL, 0);
+    if(argc > 4) seconds = strtoul(argv[4], NULL, 0);
+    if(argc > 5) lit = strtoul(argv[5], NULL, 0);
+    ram_end = AVR_SIM_RAM + ram; //the first byte after the variables
+
+    if(avr_sim_load_hex(&avr, argv[1])){
+        return 1;
+    }
+    ht1632c_sim_reset();
+    avr.io_read = io_read;
+    avr.io_write = io_write;
+    avr_sim_reset(&avr);
+
+    end = seconds * F_CPU;
+    while(avr.cycles < end){
+        unsigned long before = avr.cycles;
+
+        if(avr_sim_step(&avr)){
+            printf("%s: %s at %04x, %lu cycles in\n", argv[1], avr.fault,
+                   avr.pc * 2, before);
+            return 1;
+        }
+        timers(avr.cycles - before);
+        outside(avr.cycles);
+        interrupts();
+    }
+
+    //SP points at the next byte a push would use
+    used = AVR_SIM_RAMEND - avr.sp_min;
+    free_core = (avr.sp_min + 1 > ram_end) ? avr.sp_min + 1 - ram_end : 0;
+    for(free_painted = 0; ram_end + free_painted <= AVR_SIM_RAMEND;
+        free_painted++){
+        if(avr.data[ram_end + free_painted] != STACK_PAINT)
+            break;
+    }
+
+    printf("%lus, %lu ht1632c bits: stack %u bytes at most, "
+           "%u of %u left (painted: %u)\n", seconds, ht1632c_sim_bits(),
+           used, free_core, AVR_SIM_RAMEND + 1 - ram_end, free_painted);
+    if(lit ? !ht1632c_sim_lit_bits() : !ht1632c_sim_bits()){
+        printf("the display never came on, it can't have got far\n");
+        bad = 1;
+    }
+    if(free_core < STACK_MIN_FREE){
+        printf("the stack came within %u bytes of the variables, "
+               "STACK_MIN_FREE is %u\n", free_core, STACK_MIN_FREE);
+        bad = 1;
+    }
+    if(used > stack_min){
+        printf("the stack needed %u bytes, more than STACK_MIN (%u)\n",
+               used, stack_min);
+        bad = 1;
+    }
+    //only with DO_YOU_WANT_STACK_CHECK, otherwise nothing is painted
+    if(free_painted && (free_painted < free_core)){
+        printf("something other than the stack wrote to free RAM at %02x\n",
+               ram_end + free_painted);
+        bad = 1;
+    }
+    return bad;
+}
@@ -0,0 +1,145 @@
+//how well life_stagnant() picks when to reset, on the PC. every 16 bit
+//seed's grid (see life_seed()) is run with the column engine, with
+//life_stagnant() and the spaceship check asked each generation the way
+//main.c does, and the run is recorded: every grid is kept, so the first
+//time one comes round again shows exactly when the run settled into a
+//cycle (still lifes, oscillators, ships going round the torus, or
+//nothing). against that each reset is one of:
+//
+//  false    before the cycle started, the grid was still going somewhere
+//  late     in the cycle, and how many boring generations it was shown for
+//  missed   in a cycle by the end of the run, but never reset
+//
+//build it for both LIFE_STAGNANT ways with `make stagnation`, which runs
+//them one after the other.
+//
+//usage: stagnation [seeds [generations]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "life.h"
+
+#define HASH_BITS 14
+#define HASH_SIZE (1UL << HASH_BITS)
+
+static uint8_t (*grids)[X_AXIS_LEN]; //the run so far, grids[g] after g
+static long table[HASH_SIZE]; //generation of each grid, -1 for empty
+
+static unsigned long hash(const uint8_t *grid){
+    unsigned long h = 2166136261UL;
+    uint8_t x;
+    for(x=0; x<X_AXIS_LEN; x++){
+        h = (h ^ grid[x]) * 16777619UL;
+    }
+    return h & (HASH_SIZE - 1);
+}
+
+static long seen(unsigned long g){
+//returns the generation grids[g] was first seen at, or adds it and
+//returns -1
+    unsigned long h = hash(grids[g]);
+    
+    while(table[h] >= 0){
+        if(!memcmp(grids[table[h]], grids[g], X_AXIS_LEN)){
+            return table[h];
+        }
+        h = (h + 1) & (HASH_SIZE - 1);
+    }
+    table[h] = g;
+    return -1;
+}
+
+static uint8_t reset_due(uint8_t diff_val){
+//what get_new_states() in main.c posts a reset for
+    uint8_t reset = life_stagnant(diff_val);
+    #if LIFE_SHIP_CHECK
+    if(life_translated()){
+        reset = 1;
+    }
+    #endif
+    return reset;
+}
+
+int main(int argc, char **argv){
+    unsigned long seeds = 65535, max_gens = 3000;
+    unsigned long seed, g;
+    unsigned long resets=0, false_resets=0, late_resets=0, missed=0, running=0;
+    double cut_short=0, late=0, lived=0;
+    
+    if(argc > 1){
+        seeds = strtoul(argv[1], NULL, 0);
+    }
+    if(argc > 2){
+        max_gens = strtoul(argv[2], NULL, 0);
+    }
+    if(max_gens >= HASH_SIZE / 2){
+        max_gens = HASH_SIZE / 2 - 1;
+    }
+    grids = malloc((max_gens + 1) * X_AXIS_LEN);
+    
+    for(seed=1; seed<=seeds; seed++){
+        long cycle = -1; //generation the cycle starts at
+        unsigned long reset_at = 0;
+        
+        memset(table, 0xff, sizeof(table));
+        life_seed(seed);
+        life_all_changed();
+        life_stagnant_clear();
+        #if LIFE_SHIP_CHECK
+        life_translated_reset();
+        #endif
+        memcpy(grids[0], fb, X_AXIS_LEN);
+        seen(0);
+        
+        for(g=1; g<=max_gens; g++){
+            if(reset_due(life_step()) && !reset_at){
+                reset_at = g;
+            }
+            if(cycle < 0){
+                memcpy(grids[g], fb, X_AXIS_LEN);
+                cycle = seen(g);
+            }
+            if(reset_at && cycle >= 0){
+                break;
+            }
+        }
+        
+        if(reset_at){
+            resets++;
+            lived += reset_at;
+            if(cycle < 0 || (long)reset_at < cycle){
+                //with no cycle by max_gens, it was still going too
+                false_resets++;
+                cut_short += ((cycle < 0) ? (long)max_gens : cycle) - (long)reset_at;
+            } else {
+                late_resets++;
+                late += reset_at - cycle;
+            }
+        } else if(cycle >= 0){
+            missed++;
+        } else {
+            running++;
+        }
+    }
+    
+    #if LIFE_STAGNANT == LIFE_STAGNANT_COUNTS
+    printf("LIFE_STAGNANT_COUNTS:\n");
+    #else
+    printf("LIFE_STAGNANT_EMA (shift %u, variances %u/%u, quiet %u, steady %u):\n",
+           LIFE_EMA_SHIFT, LIFE_POP_VAR_MAX, LIFE_DIFF_VAR_MAX, LIFE_QUIET_GENS,
+           LIFE_STEADY_GENS);
+    #endif
+    printf("  %lu seeds up to %lu generations, %lu reset, average %.0f generations\n",
+           seeds, max_gens, resets, resets ? lived / resets : 0.0);
+    printf("  false resets: %lu (%.2f%%), cut short by %.0f generations on average\n",
+           false_resets, 100.0 * false_resets / seeds,
+           false_resets ? cut_short / false_resets : 0.0);
+    printf("  in a cycle:   %lu reset after %.0f boring generations on average\n",
+           late_resets, late_resets ? late / late_resets : 0.0);
+    printf("  missed:       %lu (%.2f%%) stuck in a cycle, never reset\n",
+           missed, 100.0 * missed / seeds);
+    printf("  still going:  %lu\n", running);
+    return 0;
+}
@@ -0,0 +1,37 @@
+//turns raw frames into a stream for streaming mode (see stream.h). it
+//reads 32 byte frames (column 0 first, bit 0 the top row) from stdin and
+//writes the stream to stdout, to go to the board's USI through whatever
+//SPI the computer has, e.g. `stream_cat < frames > /dev/spidev0.0`.
+//build it with `make stream_cat`.
+//
+//usage: stream_cat [-k frames]
+//  a keyframe goes every so many frames anyway, so a board that missed
+//  something (or was plugged in late) catches up. default 32, 0 for never
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/stream_enc.h"
+
+int main(int argc, char **argv){
+    uint8_t prev[STREAM_COLS], cur[STREAM_COLS], out[STREAM_ENC_MAX];
+    unsigned long every = 32, frames = 0, bytes = 0;
+    unsigned len;
+
+    if((argc > 2) && !strcmp(argv[1], "-k"))
+        every = strtoul(argv[2], NULL, 0);
+
+    while(fread(cur, 1, STREAM_COLS, stdin) == STREAM_COLS){
+        int key = !frames || (every && !(frames % every));
+        len = stream_encode(frames ? prev : NULL, cur, key, out);
+        if(fwrite(out, 1, len, stdout) != len)
+            return 1;
+        fflush(stdout);
+        memcpy(prev, cur, STREAM_COLS);
+        frames++;
+        bytes += len;
+    }
+    fprintf(stderr, "%lu frames, %lu bytes\n", frames, bytes);
+    return 0;
+}
@@ -0,0 +1,47 @@
+//makes the frames for streaming mode, see stream_enc.h
+
+#include "stream_enc.h"
+
+static unsigned finish(uint8_t *out, unsigned len){
+//adds the check byte, so the whole frame adds up to 0
+    uint8_t sum = 0;
+    unsigned i;
+    for(i=0; i<len; i++)
+        sum += out[i];
+    out[len] = -sum;
+    return len + 1;
+}
+
+unsigned stream_encode(const uint8_t *prev, const uint8_t *cur, int key, uint8_t *out){
+    uint32_t mask = 0;
+    unsigned x, len, n = 0;
+
+    if(prev && !key){
+        for(x=0; x<STREAM_COLS; x++)
+            if(prev[x] != cur[x]){
+                mask |= (uint32_t)1 << x;
+                n++;
+            }
+        //a delta is 5 bytes plus one a column, a keyframe 33
+        if(5 + n > 1 + STREAM_COLS)
+            key = 1;
+    } else {
+        key = 1;
+    }
+
+    if(key){
+        out[0] = STREAM_KEY;
+        for(x=0; x<STREAM_COLS; x++)
+            out[1 + x] = cur[x];
+        return finish(out, 1 + STREAM_COLS);
+    }
+
+    out[0] = STREAM_DELTA;
+    for(x=0; x<4; x++)
+        out[1 + x] = mask >> (8 * x);
+    len = 5;
+    for(x=0; x<STREAM_COLS; x++)
+        if(mask & ((uint32_t)1 << x))
+            out[len++] = prev[x] ^ cur[x];
+    return finish(out, len);
+}
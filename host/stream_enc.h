@@ -0,0 +1,18 @@
+//makes the frames for streaming mode (see stream.h) on the PC
+
+#ifndef STREAM_ENC_H
+#define STREAM_ENC_H
+
+#include <stdint.h>
+
+#include "stream.h"
+
+//the most bytes a frame can take, a delta with every column in it
+#define STREAM_ENC_MAX (1 + 4 + STREAM_COLS + 1)
+
+//writes the frame that takes the display from showing prev to cur into
+//out and returns its length. it's a delta unless key is set, or prev is
+//NULL, or a keyframe would be shorter.
+unsigned stream_encode(const uint8_t *prev, const uint8_t *cur, int key, uint8_t *out);
+
+#endif
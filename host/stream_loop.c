@@ -0,0 +1,110 @@
+//loopback test for streaming mode: frames go through host/stream_enc.c,
+//byte by byte through the board's decoder in stream.c, and out through
+//display.c and ht1632c.c to host/ht1632c_sim.c, the same way stream_avr.c
+//and main.c do it. every frame has to end up on the display. some of the frames get
+//a byte mangled or dropped on the way, and the display then has to be
+//right again from the next keyframe on.
+//build and run it with `make stream_loop`.
+//
+//usage: stream_loop [frames [keyframe every]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "life.h"
+#include "display.h"
+#include "stream.h"
+#include "host/stream_enc.h"
+#include "host/ht1632c_sim.h"
+
+#define SCK_HZ 50000UL //see stream_avr.c
+
+static uint8_t board_cols[STREAM_COLS]; //the board's fb
+static struct stream_state board;
+
+static void send(const uint8_t *bytes, unsigned len){
+//what the USI interrupt and the main loop do with each byte
+    unsigned i;
+    for(i=0; i<len; i++){
+        uint32_t changed = stream_byte(&board, board_cols, bytes[i]);
+        if(changed)
+            display_push(board_cols, changed);
+    }
+}
+
+static int showing(const uint8_t *cols){
+    uint8_t x;
+    for(x=0; x<STREAM_COLS; x++)
+        if(ht1632c_sim_column(x) != cols[x])
+            return 0;
+    return 1;
+}
+
+int main(int argc, char **argv){
+    unsigned long frames = 100000, every = 32;
+    unsigned long f, bytes = 0, mangled = 0, keys = 0;
+    uint8_t prev[STREAM_COLS], out[STREAM_ENC_MAX];
+    unsigned len;
+    int synced = 1;
+
+    if(argc > 1)
+        frames = strtoul(argv[1], NULL, 0);
+    if(argc > 2)
+        every = strtoul(argv[2], NULL, 0);
+
+    ht1632c_sim_reset();
+    display_init();
+    stream_begin(&board);
+
+    for(f=0; f<frames; f++){
+        int key = !f || (every && !(f % every));
+
+        //Game of Life frames, a new soup now and then
+        if(!(f % 500)){
+            uint8_t x;
+            for(x=0; x<X_AXIS_LEN; x++)
+                fb[x] = rand();
+            life_all_changed();
+        } else {
+            life_step();
+        }
+
+        len = stream_encode(f ? prev : NULL, fb, key, out);
+        if(out[0] == STREAM_KEY)
+            keys++;
+        bytes += len;
+
+        if(f && !(rand() % 97)){
+            //mangle a byte, or lose one
+            unsigned i = rand() % len;
+            if(rand() & 1){
+                out[i] ^= 1 << (rand() % 8);
+            } else {
+                memmove(out + i, out + i + 1, len - i - 1);
+                len--;
+            }
+            mangled++;
+            synced = 0;
+        } else if(out[0] == STREAM_KEY){
+            //a good keyframe, as long as the decoder is looking for a
+            //header by now. a lost byte can leave it part way through a
+            //frame, the bytes of this one finish that off then.
+            synced = (board.state == 0); //ST_HEADER in stream.c
+        }
+
+        send(out, len);
+        memcpy(prev, fb, STREAM_COLS);
+
+        if(synced && !showing(fb)){
+            printf("MISMATCH: frame %lu isn't on the display\n", f);
+            return 1;
+        }
+    }
+
+    printf("%lu frames (%lu keyframes, %lu mangled) made it to the display\n",
+           frames, keys, mangled);
+    printf("%.1f bytes a frame, up to %.0f frames a second at %lu Hz SCK\n",
+           (double)bytes / frames, SCK_HZ / 8.0 / ((double)bytes / frames), SCK_HZ);
+    return 0;
+}
@@ -0,0 +1,352 @@
+//writing and reading traces, see trace.h
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+static void put16(uint8_t *p, uint16_t v){
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t *p, uint32_t v){
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static void put64(uint8_t *p, uint64_t v){
+    put32(p, (uint32_t)v);
+    put32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint16_t get16(const uint8_t *p){
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p){
+    return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+static uint64_t get64(const uint8_t *p){
+    return get32(p) | ((uint64_t)get32(p + 4) << 32);
+}
+
+static int put(struct trace_writer *w, const uint8_t *buf, size_t n){
+    if(fwrite(buf, 1, n, w->f) != n){
+        return -1;
+    }
+    w->offset += n;
+    return 0;
+}
+
+int trace_write_open(struct trace_writer *w, const char *path,
+                     uint16_t interval){
+    uint8_t head[TRACE_HEADER] = { 'G', 'O', 'L', 'T', TRACE_VERSION,
+                                   TRACE_WIDTH, TRACE_HEIGHT, 0 };
+
+    memset(w, 0, sizeof(*w));
+    if(!interval || !(w->f = fopen(path, "wb"))){
+        return -1;
+    }
+    w->interval = interval;
+    w->key_next = 1;
+    put16(head + 8, interval);
+    return put(w, head, TRACE_HEADER);
+}
+
+int trace_write_reset(struct trace_writer *w, uint8_t reason, uint16_t seed){
+    uint8_t rec[4] = { TRACE_RESET, reason };
+
+    put16(rec + 2, seed);
+    w->last.reason = reason;
+    w->last.seed = seed;
+    w->last.gen = 0;
+    w->key_next = 1;
+    return put(w, rec, sizeof(rec));
+}
+
+static int write_key(struct trace_writer *w, uint32_t frame,
+                     const uint8_t *cells){
+    uint8_t rec[12 + TRACE_WIDTH] = { TRACE_KEY };
+
+    if((frame % w->interval) == 0){
+        if(w->keys == w->keys_max){
+            uint64_t *more;
+            w->keys_max = w->keys_max ? w->keys_max * 2 : 1024;
+            if(!(more = realloc(w->index, w->keys_max * sizeof(*more)))){
+                return -1;
+            }
+            w->index = more;
+        }
+        w->index[w->keys++] = w->offset;
+    }
+    put32(rec + 1, frame);
+    put32(rec + 5, w->last.gen);
+    put16(rec + 9, w->last.seed);
+    rec[11] = w->last.reason;
+    memcpy(rec + 12, cells, TRACE_WIDTH);
+    return put(w, rec, sizeof(rec));
+}
+
+int trace_write_frame(struct trace_writer *w, const uint8_t *cells){
+    uint8_t rec[5 + TRACE_WIDTH] = { TRACE_DELTA };
+    uint32_t frame = w->last.frame, mask = 0;
+    size_t n = 5;
+    uint8_t x;
+    int err;
+
+    if(w->key_next || (frame % w->interval) == 0){
+        err = write_key(w, frame, cells);
+        w->key_next = 0;
+    } else {
+        for(x=0; x<TRACE_WIDTH; x++){
+            if(cells[x] != w->last.cells[x]){
+                mask |= (uint32_t)1 << x;
+                rec[n++] = cells[x] ^ w->last.cells[x];
+            }
+        }
+        if(mask){
+            put32(rec + 1, mask);
+        } else {
+            rec[0] = TRACE_SAME;
+            n = 1;
+        }
+        err = put(w, rec, n);
+    }
+    memcpy(w->last.cells, cells, TRACE_WIDTH);
+    w->last.frame++;
+    w->last.gen++;
+    return err;
+}
+
+int trace_write_close(struct trace_writer *w){
+    uint8_t buf[TRACE_TRAILER];
+    uint64_t at = w->offset;
+    uint32_t i;
+    int err = 0;
+
+    buf[0] = TRACE_INDEX;
+    put32(buf + 1, w->keys);
+    err |= put(w, buf, 5);
+    for(i=0; i<w->keys; i++){
+        put64(buf, w->index[i]);
+        err |= put(w, buf, 8);
+    }
+    put64(buf, at);
+    put32(buf + 8, w->last.frame);
+    memcpy(buf + 12, "GOLE", 4);
+    err |= put(w, buf, TRACE_TRAILER);
+    if(fclose(w->f)){
+        err = -1;
+    }
+    free(w->index);
+    w->index = NULL;
+    return err ? -1 : 0;
+}
+
+static size_t record_size(const uint8_t *p, const uint8_t *end){
+//how long the record at p is, 0 if it's broken or runs off the end
+    size_t n, left = end - p;
+    uint32_t mask;
+
+    switch(p[0]){
+    case TRACE_KEY:
+        n = 12 + TRACE_WIDTH;
+        break;
+    case TRACE_DELTA:
+        if(left < 5){
+            return 0;
+        }
+        n = 5;
+        for(mask=get32(p + 1); mask; mask&=mask-1){
+            n++;
+        }
+        break;
+    case TRACE_SAME:
+        n = 1;
+        break;
+    case TRACE_RESET:
+        n = 4;
+        break;
+    default:
+        return 0;
+    }
+    return (n <= left) ? n : 0;
+}
+
+static int scan(struct trace *t){
+//finds the keyframes by reading every record, up to the index or
+//wherever the trace got cut off
+    const uint8_t *p = t->data + TRACE_HEADER, *end = t->data + t->size;
+    uint32_t max = 0;
+    size_t n;
+
+    t->frames = 0;
+    t->keys = 0;
+    while((p < end) && (n = record_size(p, end))){
+        if(p[0] == TRACE_KEY){
+            if(get32(p + 1) != t->frames){
+                break;
+            }
+            if((t->frames % t->interval) == 0){
+                if(t->keys == max){
+                    uint64_t *more;
+                    max = max ? max * 2 : 1024;
+                    if(!(more = realloc(t->scanned, max * sizeof(*more)))){
+                        return -1;
+                    }
+                    t->scanned = more;
+                }
+                t->scanned[t->keys++] = p - t->data;
+            }
+        } else if((p[0] != TRACE_RESET) && (t->frames % t->interval) == 0){
+            break; //there should have been a keyframe
+        }
+        if(p[0] != TRACE_RESET){
+            t->frames++;
+        }
+        p += n;
+    }
+    return 0;
+}
+
+int trace_open(struct trace *t, const char *path, int rescan){
+    struct stat st;
+    const uint8_t *tail;
+    uint64_t at;
+    int fd;
+
+    memset(t, 0, sizeof(*t));
+    if((fd = open(path, O_RDONLY)) < 0){
+        perror(path);
+        return -1;
+    }
+    if(fstat(fd, &st) || (st.st_size < TRACE_HEADER)){
+        fprintf(stderr, "%s: not a trace\n", path);
+        close(fd);
+        return -1;
+    }
+    t->size = st.st_size;
+    t->data = mmap(NULL, t->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(t->data == MAP_FAILED){
+        perror(path);
+        t->data = NULL;
+        return -1;
+    }
+
+    if(memcmp(t->data, "GOLT", 4) || (t->data[4] != TRACE_VERSION) ||
+       (t->data[5] != TRACE_WIDTH) || (t->data[6] != TRACE_HEIGHT) ||
+       !(t->interval = get16(t->data + 8))){
+        fprintf(stderr, "%s: not a version %u %ux%u trace\n", path,
+                TRACE_VERSION, TRACE_WIDTH, TRACE_HEIGHT);
+        trace_close(t);
+        return -1;
+    }
+
+    //the index, if it got that far and looks right
+    if(!rescan && (t->size >= TRACE_HEADER + 5 + TRACE_TRAILER) &&
+       !memcmp(t->data + t->size - 4, "GOLE", 4)){
+        tail = t->data + t->size - TRACE_TRAILER;
+        at = get64(tail);
+        t->frames = get32(tail + 8);
+        t->keys = (t->frames + t->interval - 1) / t->interval;
+        if((at >= TRACE_HEADER) && (at + 5 + 8 * (uint64_t)t->keys == t->size - TRACE_TRAILER) &&
+           (t->data[at] == TRACE_INDEX) && (get32(t->data + at + 1) == t->keys)){
+            t->index = t->data + at + 5;
+            return 0;
+        }
+    }
+    if(scan(t)){
+        fprintf(stderr, "%s: out of memory\n", path);
+        trace_close(t);
+        return -1;
+    }
+    return 0;
+}
+
+static int read_frame(const struct trace *t, struct trace_frame *f,
+                      uint64_t at, uint32_t next, uint32_t n){
+//reads the records from at, which are for frame next on, onto *f until it
+//has frame n
+    const uint8_t *p, *end = t->data + t->size;
+    size_t size;
+    uint8_t x;
+
+    if(at >= t->size){
+        return -1;
+    }
+    for(p = t->data + at; ; p += size){
+        if(!(size = record_size(p, end))){
+            return -1;
+        }
+        switch(p[0]){
+        case TRACE_KEY:
+            if(get32(p + 1) != next){
+                return -1;
+            }
+            f->gen = get32(p + 5);
+            f->seed = get16(p + 9);
+            f->reason = p[11];
+            memcpy(f->cells, p + 12, TRACE_WIDTH);
+            break;
+        case TRACE_DELTA:
+            {
+                uint32_t mask = get32(p + 1);
+                const uint8_t *xor = p + 5;
+                for(x=0; x<TRACE_WIDTH; x++){
+                    if(mask & ((uint32_t)1 << x)){
+                        f->cells[x] ^= *xor++;
+                    }
+                }
+            }
+            f->gen++;
+            break;
+        case TRACE_SAME:
+            f->gen++;
+            break;
+        default: //TRACE_RESET, the keyframe after it has it all
+            continue;
+        }
+        f->frame = next++;
+        if(f->frame == n){
+            f->next_at = (p - t->data) + size;
+            return 0;
+        }
+    }
+}
+
+int trace_seek(const struct trace *t, uint32_t n, struct trace_frame *f){
+    uint32_t key = n / t->interval;
+    uint64_t at;
+
+    if(n >= t->frames){
+        return -1;
+    }
+    //the keyframe, then deltas up to frame n
+    at = t->index ? get64(t->index + 8 * (size_t)key) : t->scanned[key];
+    if((at >= t->size) || (t->data[at] != TRACE_KEY)){
+        return -1;
+    }
+    return read_frame(t, f, at, key * t->interval, n);
+}
+
+int trace_next(const struct trace *t, struct trace_frame *f){
+    if(f->frame + 1 >= t->frames){
+        return -1;
+    }
+    return read_frame(t, f, f->next_at, f->frame + 1, f->frame + 1);
+}
+
+void trace_close(struct trace *t){
+    if(t->data){
+        munmap((void *)t->data, t->size);
+    }
+    free(t->scanned);
+    memset(t, 0, sizeof(*t));
+}
@@ -0,0 +1,103 @@
+//traces: a recording of every generation of a run, small enough to keep
+//days of them, and quick to jump around in. written with trace_write_...
+//(host/trace_rec.c records one from libgol) and read back with trace_open()
+//and trace_seek(), which maps the file rather than reading it in.
+//
+//a trace is a header, then records, then an index of the keyframes:
+//
+//  header     "GOLT", version, width, height, 0, keyframe interval (2 bytes)
+//  'K' frame  keyframe: frame number (4), generations since the grid was
+//             started (4), its seed (2), the RESET_EV_... bits that
+//             started it (1, see main.c), then every column
+//  'D' frame  delta: a mask of the columns that changed (4), then each of
+//             those columns XORed with what it was, column 0 first
+//  'S' frame  same as the frame before
+//  'R'        reset marker: reason (1) and seed (2) of the next grid,
+//             whose first frame is always a keyframe
+//  'I'        index: how many (4), then where each keyframe for frame
+//             0, interval, 2*interval... starts in the file (8 each)
+//  trailer    where the index starts (8), frames (4), "GOLE"
+//
+//there's a keyframe at least every interval frames, so getting any frame
+//is one keyframe and fewer than interval deltas. everything is low byte
+//first. a trace that was cut off (the recorder got killed, the disk
+//filled) has no trailer, trace_open() then finds the keyframes itself
+//and everything up to the last whole frame can still be read.
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TRACE_WIDTH 32 //X_AXIS_LEN
+#define TRACE_HEIGHT 8 //Y_AXIS_LEN
+#define TRACE_VERSION 1
+#define TRACE_HEADER 12
+#define TRACE_TRAILER 16
+
+#define TRACE_KEY 'K'
+#define TRACE_DELTA 'D'
+#define TRACE_SAME 'S'
+#define TRACE_RESET 'R'
+#define TRACE_INDEX 'I'
+
+//one frame, as trace_seek() gives it back
+struct trace_frame {
+    uint32_t frame; //position in the trace, from 0
+    uint32_t gen; //generations since its grid was started
+    uint16_t seed; //what its grid was made from, see life_seed()
+    uint8_t reason; //RESET_EV_... bits that started its grid
+    uint8_t cells[TRACE_WIDTH]; //columns like fb, bit 0 is the top row
+    uint64_t next_at; //where the frame after it starts, for trace_next()
+};
+
+struct trace_writer {
+    FILE *f;
+    uint64_t offset; //bytes written so far
+    uint16_t interval;
+    struct trace_frame last; //cells of the last frame, the rest for the next
+    uint8_t key_next; //set when the next frame has to be a keyframe
+    uint64_t *index;
+    uint32_t keys, keys_max;
+};
+
+//all return 0, or -1 if writing didn't work
+int trace_write_open(struct trace_writer *w, const char *path,
+                     uint16_t interval);
+
+//the next frame starts a new grid, made from seed because of reason
+int trace_write_reset(struct trace_writer *w, uint8_t reason, uint16_t seed);
+
+//adds the next generation, TRACE_WIDTH columns
+int trace_write_frame(struct trace_writer *w, const uint8_t *cells);
+
+//writes the index and closes the file
+int trace_write_close(struct trace_writer *w);
+
+struct trace {
+    const uint8_t *data; //the whole file, mapped
+    size_t size;
+    uint16_t interval;
+    uint32_t frames;
+    uint32_t keys; //entries in index
+    const uint8_t *index; //8 bytes each, in the file when it has one
+    uint64_t *scanned; //or found by reading it all
+};
+
+//maps the trace at path. rescan ignores the index and finds the keyframes
+//by reading it all, like it has to for a trace that was cut off.
+//returns 0, or -1 and prints why
+int trace_open(struct trace *t, const char *path, int rescan);
+
+//gets frame n into *f, returns 0 or -1 if it isn't there or is broken
+int trace_seek(const struct trace *t, uint32_t n, struct trace_frame *f);
+
+//replaces *f, from trace_seek() or trace_next(), with the frame after it
+//without going back to a keyframe, for playing a trace through
+int trace_next(const struct trace *t, struct trace_frame *f);
+
+void trace_close(struct trace *t);
+
+#endif
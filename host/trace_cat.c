@@ -0,0 +1,122 @@
+//looks at a trace (see trace.h). with just the file it plays the whole
+//thing through and prints what's in it: how many grids, why they were
+//reset, how long they lasted. with a frame number it prints the grids
+//from there, found with trace_seek() so it's quick anywhere in the trace.
+//build it with `make trace_cat`.
+//
+//usage: trace_cat trace [frame [count]]
+//  frame: first frame to print
+//  count: how many frames to print, default 1
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "trace.h"
+
+//the RESET_EV_... bits from main.c, in order
+static const char *const reasons[] = {
+    "stagnant", "button", "gen limit", "watchdog", "power on", "wall",
+};
+#define NB_REASONS (sizeof(reasons) / sizeof(reasons[0]))
+
+static void print_reason(uint8_t reason){
+    unsigned i;
+    const char *sep = "";
+
+    for(i=0; i<8; i++){
+        if(reason & (1 << i)){
+            if(i < NB_REASONS){
+                printf("%s%s", sep, reasons[i]);
+            } else {
+                printf("%sbit %u", sep, i);
+            }
+            sep = ", ";
+        }
+    }
+}
+
+static void print_frame(const struct trace_frame *f){
+    uint8_t x, y;
+
+    printf("frame %lu: seed 0x%04x generation %lu (", (unsigned long)f->frame,
+           f->seed, (unsigned long)f->gen);
+    print_reason(f->reason);
+    printf(")\n");
+    for(y=0; y<TRACE_HEIGHT; y++){
+        for(x=0; x<TRACE_WIDTH; x++){
+            putchar((f->cells[x] & (1 << y)) ? '#' : '.');
+        }
+        putchar('\n');
+    }
+}
+
+static int summary(const struct trace *t){
+    struct trace_frame f;
+    unsigned long grids = 0, count[NB_REASONS] = { 0 }, lasted = 0, i;
+    unsigned r;
+
+    for(i=0; i<t->frames; i++){
+        if(i ? trace_next(t, &f) : trace_seek(t, 0, &f)){
+            printf("broken at frame %lu\n", i);
+            return 1;
+        }
+        if(f.gen == 0){
+            grids++;
+            for(r=0; r<NB_REASONS; r++){
+                if(f.reason & (1 << r)){
+                    count[r]++;
+                }
+            }
+        } else {
+            lasted++;
+        }
+    }
+    printf("%lu frames, keyframe every %u, %.2f bytes a frame%s\n",
+           (unsigned long)t->frames, t->interval,
+           t->frames ? (double)t->size / t->frames : 0.0,
+           t->index ? "" : ", no index (cut off?)");
+    printf("%lu grids, %.0f generations each on average\n", grids,
+           grids ? (double)lasted / grids : 0.0);
+    for(r=0; r<NB_REASONS; r++){
+        if(count[r]){
+            printf("  %-10s %lu\n", reasons[r], count[r]);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv){
+    struct trace t;
+    struct trace_frame f;
+    unsigned long first, count = 1, i;
+    int err = 0;
+
+    if(argc < 2){
+        fprintf(stderr, "usage: trace_cat trace [frame [count]]\n");
+        return 1;
+    }
+    if(trace_open(&t, argv[1], 0)){
+        return 1;
+    }
+    if(argc < 3){
+        err = summary(&t);
+    } else {
+        first = strtoul(argv[2], NULL, 0);
+        if(argc > 3){
+            count = strtoul(argv[3], NULL, 0);
+        }
+        for(i=0; i<count; i++){
+            if(i ? trace_next(&t, &f) : trace_seek(&t, first, &f)){
+                if(!i){
+                    printf("no frame %lu, the trace has %lu\n", first,
+                           (unsigned long)t.frames);
+                    err = 1;
+                }
+                break;
+            }
+            print_frame(&f);
+        }
+    }
+    trace_close(&t);
+    return err;
+}
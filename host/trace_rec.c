@@ -0,0 +1,165 @@
+//records a trace (see trace.h) of a board running for a long time, from
+//libgol (see gol.h): grid after grid, every generation the display would
+//have shown, with a reset marker and the seed each time a new grid goes
+//on. the board's own rand() isn't worth copying, the seeds come from
+//life_seed_next() instead.
+//
+//then it checks the trace: every frame read back in order with
+//trace_next(), and lots at random with trace_seek(), both with the index
+//and with the keyframes found by reading it all, have to be what was
+//recorded. it prints how big it came out and how long a seek takes.
+//build and run it with `make trace_rec`.
+//
+//usage: trace_rec trace [frames [interval [seed]]]
+//  trace: where to write it, `make trace_rec` puts it in the build's host
+//  directory
+//  frames: how many generations, default 1000000 (about 6 days)
+//  interval: frames between keyframes, default 256
+//  seed: for the first grid, default 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gol.h"
+#include "trace.h"
+
+#if (GOL_WIDTH != TRACE_WIDTH) || (GOL_HEIGHT != TRACE_HEIGHT)
+#error "traces are of 32x8 grids"
+#endif
+
+//the RESET_EV_... bits from main.c
+#define RESET_EV_STAGNANT (1<<0)
+#define RESET_EV_POWER_ON (1<<4)
+
+#define SEEKS 100000
+
+static struct trace_frame *want; //every frame, as it was recorded
+
+static int same(const struct trace_frame *a, const struct trace_frame *b){
+    return (a->frame == b->frame) && (a->gen == b->gen) &&
+           (a->seed == b->seed) && (a->reason == b->reason) &&
+           !memcmp(a->cells, b->cells, TRACE_WIDTH);
+}
+
+static int check(const char *path, int rescan, unsigned long frames){
+//reads the trace back, returns 0 if it's all there
+    struct trace t;
+    struct trace_frame f;
+    unsigned long i, n;
+    clock_t start;
+
+    if(trace_open(&t, path, rescan)){
+        return 1;
+    }
+    if(t.frames != frames){
+        printf("MISMATCH: %lu frames recorded, %lu in the trace\n",
+               frames, (unsigned long)t.frames);
+        return 1;
+    }
+    for(i=0; i<frames; i++){
+        if((i ? trace_next(&t, &f) : trace_seek(&t, 0, &f)) || !same(&f, &want[i])){
+            printf("MISMATCH: frame %lu read in order\n", i);
+            return 1;
+        }
+    }
+    start = clock();
+    for(i=0; i<SEEKS; i++){
+        n = ((unsigned long)rand() * (RAND_MAX + 1UL) + rand()) % frames;
+        if(trace_seek(&t, n, &f) || !same(&f, &want[n])){
+            printf("MISMATCH: frame %lu from trace_seek()\n", n);
+            return 1;
+        }
+    }
+    printf("%s: every frame in order and %u seeks agree, %.1fus a seek\n",
+           rescan ? "keyframes found by reading it" : "with the index",
+           SEEKS, 1e6 * (clock() - start) / CLOCKS_PER_SEC / SEEKS);
+    trace_close(&t);
+    return 0;
+}
+
+int main(int argc, char **argv){
+    const char *path;
+    unsigned long frames = 1000000, interval = 256, i, grids = 0;
+    uint16_t seed = 1;
+    uint8_t reason = RESET_EV_POWER_ON;
+    struct trace_writer w;
+    struct gol_grid g;
+    FILE *f;
+    long size;
+
+    if(argc < 2){
+        fprintf(stderr, "usage: trace_rec trace [frames [interval [seed]]]\n");
+        return 1;
+    }
+    path = argv[1];
+    if(argc > 2){
+        frames = strtoul(argv[2], NULL, 0);
+    }
+    if(argc > 3){
+        interval = strtoul(argv[3], NULL, 0);
+    }
+    if(argc > 4){
+        seed = strtoul(argv[4], NULL, 0);
+    }
+    if(!frames || !interval || (interval > 0xffff)){
+        printf("frames and interval (up to 65535) can't be 0\n");
+        return 1;
+    }
+    if(!GOL_CHECK()){
+        printf("libgol was built with other LIFE_ options\n");
+        return 1;
+    }
+    if(!(want = malloc(frames * sizeof(*want)))){
+        printf("out of memory\n");
+        return 1;
+    }
+    if(trace_write_open(&w, path, interval)){
+        perror(path);
+        return 1;
+    }
+
+    for(i=0; i<frames; ){
+        if(!seed){
+            seed = 1; //life_seed() does the same
+        }
+        gol_seed(&g, seed);
+        grids++;
+        trace_write_reset(&w, reason, seed);
+        //the new grid is shown, then each generation until the one it
+        //gets reset on, which is replaced straight away
+        do{
+            want[i].frame = i;
+            want[i].gen = g.generations;
+            want[i].seed = seed;
+            want[i].reason = reason;
+            memcpy(want[i].cells, g.cells, TRACE_WIDTH);
+            if(trace_write_frame(&w, g.cells)){
+                perror(path);
+                return 1;
+            }
+            i++;
+        }while((i < frames) && gol_step_many(&g, 1, 1));
+        seed = life_seed_next(seed);
+        reason = RESET_EV_STAGNANT;
+    }
+    if(trace_write_close(&w)){
+        perror(path);
+        return 1;
+    }
+
+    if((f = fopen(path, "rb")) && !fseek(f, 0, SEEK_END) && ((size = ftell(f)) > 0)){
+        printf("%s: %lu frames of %lu grids in %ld bytes, %.2f bytes a frame, keyframe every %lu\n",
+               path, frames, grids, size, (double)size / frames, interval);
+    }
+    if(f){
+        fclose(f);
+    }
+
+    if(check(path, 0, frames) || check(path, 1, frames)){
+        return 1;
+    }
+    free(want);
+    return 0;
+}
@@ -0,0 +1,174 @@
+//runs a wall of several boards on the PC, each with its own 32x8 grid in
+//life.c built with LIFE_HALO, swapping edge columns every generation
+//through the same link.c code the boards use, one CLK edge at a time.
+//every generation the whole wall is checked against one big torus worked
+//out cell by cell here, which is what the wall is supposed to look like.
+//like main.c, only the master (board 0) decides when the grid has got
+//boring, from its own part, and every board starts a new grid at the end
+//of the generation after, once the master has told them with its sync.
+//build and run it with `make wall_sim`.
+//
+//usage: wall_sim [boards [generations [seed]]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "life.h"
+#include "link.h"
+
+#if !LIFE_HALO
+#error "build this with -DLIFE_HALO=1"
+#endif
+
+#define MAX_BOARDS 16
+
+struct board {
+    uint8_t grid[X_AXIS_LEN];
+    uint32_t changed;
+    uint8_t halo_left, halo_right;
+    struct link_state link;
+};
+
+static struct board boards[MAX_BOARDS];
+static uint8_t wall[MAX_BOARDS * X_AXIS_LEN]; //the big torus
+static unsigned num_boards;
+static unsigned long resets;
+
+static void load(const struct board *b){
+    memcpy(fb, b->grid, X_AXIS_LEN);
+    life_changed = b->changed;
+    life_halo_left = b->halo_left;
+    life_halo_right = b->halo_right;
+}
+
+static void save(struct board *b){
+    memcpy(b->grid, fb, X_AXIS_LEN);
+    b->changed = life_changed;
+    b->halo_left = life_halo_left;
+    b->halo_right = life_halo_right;
+}
+
+//what the wires between the boards carry, one generation's worth
+static void run_link(void){
+    uint8_t out[MAX_BOARDS];
+    unsigned b, bit;
+
+    for(b=0;b<num_boards;b++){
+        link_begin(&boards[b].link, boards[b].grid[0],
+                   boards[b].grid[X_AXIS_LEN-1]);
+    }
+    for(bit=0;bit<LINK_BITS;bit++){
+        //falling edge, everyone drives TX_L and TX_R
+        for(b=0;b<num_boards;b++){
+            out[b] = link_clock_low(&boards[b].link);
+        }
+        //rising edge, RX_L is the left board's TX_R and so on
+        for(b=0;b<num_boards;b++){
+            unsigned left = (b + num_boards - 1) % num_boards;
+            unsigned right = (b + 1) % num_boards;
+            uint8_t in = 0;
+            if(out[left] & LINK_RIGHT) in |= LINK_LEFT;
+            if(out[right] & LINK_LEFT) in |= LINK_RIGHT;
+            link_clock_high(&boards[b].link, in);
+        }
+    }
+}
+
+static void reset_wall(void){
+//what service_resets() does on every board, here with one big seed
+    unsigned b, x;
+
+    for(x=0;x<num_boards * X_AXIS_LEN;x++){
+        wall[x] = (uint8_t)rand();
+    }
+    for(b=0;b<num_boards;b++){
+        memcpy(boards[b].grid, &wall[b * X_AXIS_LEN], X_AXIS_LEN);
+        boards[b].changed = 0xffffffff;
+    }
+    life_stagnant_clear();
+    resets++;
+}
+
+static uint8_t wall_cell(int x, int y){
+    unsigned w = num_boards * X_AXIS_LEN;
+    x = (x + w) % w;
+    y = (y + Y_AXIS_LEN) % Y_AXIS_LEN;
+    return (wall[x] >> y) & 1;
+}
+
+static void step_wall(void){
+    uint8_t next[MAX_BOARDS * X_AXIS_LEN];
+    unsigned w = num_boards * X_AXIS_LEN;
+    int x, y, dx, dy;
+
+    for(x=0;x<(int)w;x++){
+        next[x] = 0;
+        for(y=0;y<Y_AXIS_LEN;y++){
+            int n = 0;
+            for(dx=-1;dx<=1;dx++)
+                for(dy=-1;dy<=1;dy++)
+                    if(dx || dy)
+                        n += wall_cell(x+dx, y+dy);
+            if((n == 3) || ((n == 2) && wall_cell(x, y)))
+                next[x] |= (1<<y);
+        }
+    }
+    memcpy(wall, next, w);
+}
+
+int main(int argc, char **argv){
+    unsigned long generations = 1000, g;
+    unsigned b;
+    uint8_t wall_reset = 0, sent;
+
+    num_boards = 4;
+    srand(1);
+    if(argc > 1) num_boards = strtoul(argv[1], NULL, 0);
+    if(argc > 2) generations = strtoul(argv[2], NULL, 0);
+    if(argc > 3) srand(strtoul(argv[3], NULL, 0));
+    if((num_boards < 1) || (num_boards > MAX_BOARDS)){
+        printf("1 to %u boards\n", MAX_BOARDS);
+        return 1;
+    }
+
+    reset_wall();
+    resets = 0;
+
+    for(g=0;g<generations;g++){
+        //the reset the master asked for last time goes out with the sync
+        sent = wall_reset;
+        wall_reset = 0;
+        run_link();
+        for(b=0;b<num_boards;b++){
+            uint8_t diff_val;
+
+            load(&boards[b]);
+            life_set_halo(boards[b].link.rx_left, boards[b].link.rx_right);
+            diff_val = life_step();
+            if(!b && life_stagnant(diff_val)){
+                wall_reset = 1;
+            }
+            save(&boards[b]);
+        }
+        step_wall();
+
+        for(b=0;b<num_boards;b++){
+            if(memcmp(boards[b].grid, &wall[b * X_AXIS_LEN], X_AXIS_LEN)){
+                printf("MISMATCH: board %u, generation %lu\n", b, g);
+                return 1;
+            }
+        }
+        if(sent){
+            reset_wall();
+        }
+    }
+
+    printf("%u boards (%ux%u) agree with one big torus for %lu generations\n",
+           num_boards, num_boards * X_AXIS_LEN, Y_AXIS_LEN, generations);
+    printf("the master reset the whole wall %lu times\n", resets);
+    printf("link: %u bits each way per board per generation, "
+           "%lu us per generation (%u ms sync + %u clocks)\n",
+           LINK_BITS, (unsigned long)LINK_TICK_US, LINK_SYNC_MS, LINK_BITS);
+    return 0;
+}
@@ -14,11 +14,23 @@
 #define HT1632C_WRCLK       _BV(4)
 #define HT1632C_DATA        _BV(5)
 
+#ifdef HT1632C_RD_BIT
+#ifndef HT1632C_RD_PORT
+#define HT1632C_RD_PORT     PORTA
+#define HT1632C_RD_DDR      DDRA
+#endif
+#define HT1632C_DATA_PIN    PINB
+#define HT1632C_RD          _BV(HT1632C_RD_BIT)
+#endif
+
 /*
 #define BIT_SLEEP do { asm volatile ("nop;\n\tnop;\n\tnop;\n"); } while(0)
 */
 #define BIT_SLEEP do { } while(0)
 
+/* RD has to stay low a while before the data is valid (~1us) */
+#define RD_SLEEP do { asm volatile ("nop\n\tnop\n\tnop\n\tnop\n\tnop\n\tnop\n\tnop\n\tnop\n"); } while(0)
+
 static void
 ht1632c_start(void)
 {
@@ -131,6 +143,98 @@ ht1632c_data8(uint8_t addr, uint8_t byte)
     ht1632c_stop();
 }
 
+/* successive address write, only sends the command and address once */
+void
+ht1632c_write_burst(uint8_t addr, const uint8_t *bytes, uint8_t n)
+{
+    ht1632c_start();
+    HT1632C_BITS(0x05,  3 );  /* 1 0 1 */
+    HT1632C_BITS(addr,  7 );  /* ... address ... */
+    while ( n-- )
+        HT1632C_BITS(*bytes++, 8 );
+    ht1632c_stop();
+}
+
+#ifdef HT1632C_RD_BIT
+
+/* clock n bits out of the ht1632c with RD, MSB first. the ht1632c puts a
+ * bit on DATA after each falling edge of RD, and moves to the next
+ * address by itself every 4 bits. DATA has to be an input meanwhile. */
+static uint8_t
+ht1632c_read_bits(uint8_t n)
+{
+    uint8_t val = 0;
+
+    HT1632C_DDR &= ~ HT1632C_DATA;
+    HT1632C_PORT &= ~ HT1632C_DATA; /* no pullup */
+    while ( n-- ) {
+        HT1632C_RD_PORT &= ~ HT1632C_RD;
+        RD_SLEEP;
+        val <<= 1;
+        if ( HT1632C_DATA_PIN & HT1632C_DATA )
+            val |= 1;
+        HT1632C_RD_PORT |= HT1632C_RD;
+        RD_SLEEP;
+    }
+    HT1632C_DDR |= HT1632C_DATA;
+    return val;
+}
+
+static void
+ht1632c_read_start(uint8_t addr)
+{
+    ht1632c_start();
+    HT1632C_BITS(0x06,  3 );  /* 1 1 0 */
+    HT1632C_BITS(addr,  7 );  /* ... address ... */
+}
+
+uint8_t
+ht1632c_read4(uint8_t addr)
+{
+    uint8_t val;
+    ht1632c_read_start(addr);
+    val = ht1632c_read_bits(4);
+    ht1632c_stop();
+    return val;
+}
+
+uint8_t
+ht1632c_read8(uint8_t addr)
+{
+    uint8_t val;
+    ht1632c_read_start(addr);
+    val = ht1632c_read_bits(8);
+    ht1632c_stop();
+    return val;
+}
+
+/* successive address read, only sends the command and address once */
+void
+ht1632c_read_burst(uint8_t addr, uint8_t *buf, uint8_t n)
+{
+    ht1632c_read_start(addr);
+    while ( n-- )
+        *buf++ = ht1632c_read_bits(4);
+    ht1632c_stop();
+}
+
+#endif
+
+/* the ht1632c moves to the next address by itself every 4 bits, so the
+ * whole 64 nibbles only need the command and address sent once */
+void
+ht1632c_clear(void)
+{
+    uint8_t i;
+
+    ht1632c_start();
+    HT1632C_BITS(0x05,  3 );  /* 1 0 1 */
+    HT1632C_BITS(0,     7 );  /* ... address 0 ... */
+    for(i=0;i<32;i++)
+        HT1632C_BITS(0, 8 );  /* ... 2 nibbles at a time */
+    ht1632c_stop();
+}
+
 void
 ht1632c_clear_fb(uint8_t *fbmem)
 {
@@ -182,16 +286,26 @@ ht1632c_flush_fb(uint8_t *fbmem)
 }
 
 void
-ht1632c_init(void)
+ht1632c_init_pins(void)
 {
     uint8_t mask = HT1632C_WRCLK | HT1632C_CS | HT1632C_DATA;
-    int i;
 
     HT1632C_PORT |= mask;
     HT1632C_DDR  |= mask;
 
+#ifdef HT1632C_RD_BIT
+    HT1632C_RD_PORT |= HT1632C_RD; /* RD idles high */
+    HT1632C_RD_DDR  |= HT1632C_RD;
+#endif
+
     ht1632c_start();
     ht1632c_stop();
+}
+
+void
+ht1632c_init(void)
+{
+    ht1632c_init_pins();
 
     ht1632c_onoff(0);
     ht1632c_onoff(1);
@@ -200,9 +314,9 @@ ht1632c_init(void)
     ht1632c_opts(0);  /* 0: 8 commons, n-mos outputs */
     ht1632c_bright(7);//set brightness to 7/16 pwm
 
-    /* clear buffer memory */
-    for(i=0;i<64;i++)
-        ht1632c_data4(i,i);
+    /* clear buffer memory, before the LEDs get turned on
+     * so whatever was in there at power on never shows */
+    ht1632c_clear();
 
     ht1632c_ledonoff(1); /* turn on */
 }
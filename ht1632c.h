@@ -36,12 +36,41 @@ extern void ht1632c_opts(uint8_t val);
 /* set up everything related to the ht1632c */
 extern void ht1632c_init(void);
 
+/* only set up the pins and end any transaction that was cut off, for
+ * when the mcu has been reset but the ht1632c hasn't (ht1632c_init()
+ * does this first too) */
+extern void ht1632c_init_pins(void);
+
+/* set all of the ht1632c data ram to 0 with one successive-address write */
+extern void ht1632c_clear(void);
+
 /* write 4 bits to ht1632c data ram */
 extern void ht1632c_data4(uint8_t addr, uint8_t nibble);
 
 /* write 4 MSBs of byte to addr, 4 LSB of byte to addr+1 */
 extern void ht1632c_data8(uint8_t addr, uint8_t byte);
 
+/* write n bytes like ht1632c_data8, from addr on, with one successive
+ * address write */
+extern void ht1632c_write_burst(uint8_t addr, const uint8_t *bytes, uint8_t n);
+
+/* the RD line is only needed to read the ht1632c's RAM back, there's no
+ * spare pin for it on the stock board, so define HT1632C_RD_BIT (and
+ * HT1632C_RD_PORT/HT1632C_RD_DDR if it isn't on PORTA) from the Makefile
+ * to turn it on, see the display_ram variant. */
+#ifdef HT1632C_RD_BIT
+
+/* read 4 bits from ht1632c data ram */
+extern uint8_t ht1632c_read4(uint8_t addr);
+
+/* read addr as the 4 MSBs and addr+1 as the 4 LSBs, like ht1632c_data8 */
+extern uint8_t ht1632c_read8(uint8_t addr);
+
+/* read n nibbles starting at addr into buf, one nibble per byte */
+extern void ht1632c_read_burst(uint8_t addr, uint8_t *buf, uint8_t n);
+
+#endif
+
 /* flush a 32byte/8bit framebuffer to LED matrix */
 extern void ht1632c_flush_fb(uint8_t *fbmem);
 
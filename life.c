@@ -0,0 +1,685 @@
+//the Game of Life engine
+
+//some functions are based on code from this site:
+// http://www.daqq.eu/?p=250
+// which was an implementation of Conway's Game of Life
+// on a 20x4 character LCD using an ATtiny2313 mcu.
+
+#include "life.h"
+
+uint8_t fb[X_AXIS_LEN] LIFE_NOINIT;      /* framebuffer */
+#if LIFE_STATE_STORAGE
+uint8_t state_storage[X_AXIS_LEN]; //area to store pixel states,
+                                   //only life_step_pixel() uses it
+                                   //(and LIFE_PRESCREEN as its grid)
+#endif
+
+uint32_t life_changed = 0xffffffff;
+
+#if LIFE_HALO
+uint8_t life_halo_left=0;
+uint8_t life_halo_right=0;
+static uint8_t halo_changed=0; //bit 0 left, bit 1 right
+#endif
+
+struct life_stagnation life_stag LIFE_NOINIT;
+
+//life_asm.S has its own, so the C one is only for the seed prescreen then
+#define LIFE_COLUMN_C (!LIFE_STEP_ASM || LIFE_PRESCREEN)
+
+#if LIFE_COLUMN_C
+static uint8_t life_column(uint8_t l, uint8_t c, uint8_t r);
+#endif
+
+#if LIFE_SHIP_CHECK
+struct life_ship life_ship;
+
+static uint8_t ship_shifted(uint8_t dx, uint8_t dy);
+#endif
+
+void life_all_changed(void){
+    life_changed = 0xffffffff;
+}
+
+#if LIFE_HALO
+void life_set_halo(uint8_t left, uint8_t right){
+    if(left != life_halo_left){
+        halo_changed |= 1;
+    }
+    if(right != life_halo_right){
+        halo_changed |= 2;
+    }
+    life_halo_left = left;
+    life_halo_right = right;
+}
+#endif
+
+static uint8_t col_pop(uint8_t col){
+//live cells in a column
+    uint8_t n=0;
+    
+    for(; col; col &= col-1){ //clears the lowest set bit each time round
+        n++;
+    }
+    return n;
+}
+
+#define QUIET_START 0xff //st->quiet before a grid's first generation
+
+static void stagnant_clear(struct life_stagnation *st){
+    uint8_t i;
+    
+    for(i=0; i<sizeof(*st); i++){
+        ((uint8_t *)st)[i] = 0;
+    }
+    #if LIFE_STAGNANT != LIFE_STAGNANT_COUNTS
+    st->quiet = QUIET_START;
+    #endif
+}
+
+#if LIFE_STAGNANT == LIFE_STAGNANT_COUNTS
+
+static uint8_t stagnant(struct life_stagnation *st, uint8_t diff_val,
+                        uint16_t pop){
+//life_stagnant() with the counters passed in, so the seed prescreen
+//can keep its own
+    (void)pop;
+    
+    if((diff_val <= 4)){
+        //if diff_val is a low difference then increment it's counter
+        st->low++;
+    }
+    else if((diff_val<=8)){
+        //if diff_val is a medium difference then increment that counter
+        st->med++;
+    }
+    else{
+        //if neither, then decrement their counters to stay longer before reset
+        if(st->low > 0){
+            st->low--;
+        }
+        if(st->med >0){
+            st->med--;
+        }
+    }
+    
+    if(st->low > LOW_DIFF_THRESHOLD){
+    //if low_diff_count is above threshold, reset
+        st->low=0;
+        return 1;
+    }
+    else if(st->med > MED_DIFF_THRESHOLD){
+    //if med_diff_count is above threshold, reset
+        st->med=0;
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+//moves avg 1/2^shift of the way to x. the decay is rounded up,
+//so an average can get all the way down to 0.
+#define EMA(avg, x, shift) ((avg) - (((avg) + (1 << (shift)) - 1) >> (shift)) \
+                            + ((x) >> (shift)))
+
+static uint16_t ema_var(int16_t *avg, uint16_t var, uint16_t x){
+//moves avg (4 fraction bits) towards x, and returns var moved towards how
+//far x was from it, squared
+    int16_t dev;
+    uint8_t d;
+    
+    dev = (int16_t)(x << 4) - *avg;
+    *avg += dev >> LIFE_EMA_SHIFT;
+    //whole cells, clipped so the square (in 1/16ths) fits in 16 bits
+    dev >>= 4;
+    if(dev < 0){
+        dev = -dev;
+    }
+    d = (dev > 63) ? 63 : dev;
+    return EMA(var, (uint16_t)(d * d) << 4, LIFE_EMA_SHIFT);
+}
+
+static uint8_t stagnant(struct life_stagnation *st, uint8_t diff_val,
+                        uint16_t pop){
+//life_stagnant() with the state passed in, so the seed prescreen
+//can keep its own
+    uint16_t pop2, band, off;
+    uint8_t diff2;
+    
+    if(st->quiet == QUIET_START){
+        //the first generation of a grid, start the averages off there
+        //rather than at 0, which would look like a lot going on for a while
+        st->last_pop = (pop > 255) ? 255 : pop;
+        st->last_diff = diff_val;
+        st->pop = (pop * 2) << 4;
+        st->diff = (diff_val * 2) << 4;
+        st->quiet = 0;
+    }
+    //over two generations, so period 2 oscillators (most of what's left
+    //on a grid this small) come out the same every time
+    pop2 = pop + st->last_pop;
+    diff2 = diff_val + st->last_diff;
+    st->last_pop = (pop > 255) ? 255 : pop;
+    st->last_diff = diff_val;
+    st->pop_var = ema_var(&st->pop, st->pop_var, pop2);
+    st->diff_var = ema_var(&st->diff, st->diff_var, diff2);
+    //slower, so it stays put while pop_var goes up and down with a cycle
+    st->pop_var_avg = EMA(st->pop_var_avg, st->pop_var, LIFE_EMA_SHIFT + 1);
+    
+    if((st->pop_var > LIFE_POP_VAR_MAX) || (st->diff_var > LIFE_DIFF_VAR_MAX)){
+        st->quiet = 0;
+    }
+    else if(++st->quiet > LIFE_QUIET_GENS){
+        stagnant_clear(st);
+        return 1;
+    }
+    
+    //within half of pop_var_avg, and a bit for when it's near 0. how far
+    //off it is is taken smaller from bigger, adding band to either of
+    //them could wrap past 0xffff
+    band = (st->pop_var_avg >> 1) + 4;
+    if(st->pop_var < st->pop_var_avg){
+        off = st->pop_var_avg - st->pop_var;
+    } else {
+        off = st->pop_var - st->pop_var_avg;
+    }
+    if(off > band){
+        st->steady = 0;
+    }
+    else if(++st->steady > LIFE_STEADY_GENS - 1){
+        stagnant_clear(st);
+        return 1;
+    }
+    return 0;
+}
+
+#endif
+
+void life_stagnant_clear(void){
+    stagnant_clear(&life_stag);
+}
+
+uint8_t life_stagnant(uint8_t diff_val){
+    #if LIFE_STAGNANT == LIFE_STAGNANT_COUNTS
+    return stagnant(&life_stag, diff_val, 0);
+    #else
+    return stagnant(&life_stag, diff_val, life_population());
+    #endif
+}
+
+#if LIFE_WARM_RESTART
+
+//mixes byte b into sum, a rotate first so moved bits don't cancel out
+#define SUM_IN(sum,b) ((uint16_t)(((sum) << 1) | ((sum) >> 15)) + (b))
+
+uint16_t life_state_sum(uint16_t sum){
+    uint8_t x;
+    
+    for(x=0; x<X_AXIS_LEN; x++){
+        sum = SUM_IN(sum, LIFE_COL(x));
+    }
+    for(x=0; x<sizeof(life_stag); x++){
+        sum = SUM_IN(sum, ((uint8_t *)&life_stag)[x]);
+    }
+    return sum;
+}
+
+#endif
+
+uint16_t life_population(void){
+    uint16_t pop=0;
+    uint8_t x;
+    
+    for(x=0; x<X_AXIS_LEN; x++){
+        pop += col_pop(LIFE_COL(x));
+    }
+    return pop;
+}
+
+uint8_t get_current_pixel_state(uint8_t in[], int8_t x,int8_t y){
+//get the state (1==alive,0==dead), of a particular pixel/cell and return it
+
+    //for wrapping the display axis so the 
+    //Game of Life doesn't seem as restricted
+    //this is called a toroidal array
+    //(or not, see LIFE_TOPOLOGY in life.h)
+    #if LIFE_TOPOLOGY == LIFE_PLANE
+    if((x < 0) || (x == X_AXIS_LEN)){ return 0;}
+    #else
+    if((x < 0) || (x == X_AXIS_LEN)){
+        x = (x < 0) ? (X_AXIS_LEN - 1) : 0;
+        #if LIFE_TOPOLOGY == LIFE_KLEIN
+        //comes back in upside down
+        y = (Y_AXIS_LEN - 1) - y;
+        #endif
+    }
+    #endif
+    #if LIFE_WRAPS_Y
+    if(y < 0){ y = (Y_AXIS_LEN-1);}
+    if(y == Y_AXIS_LEN) {y = 0;}
+    #else
+    if((y < 0) || (y == Y_AXIS_LEN)){ return 0;}
+    #endif
+    
+    //return the value
+    return (in[x] & (1<<y));
+}
+
+uint8_t get_new_pixel_state(uint8_t in_states[], int8_t x,int8_t y){
+    
+    uint8_t n=0;//to store the neighbor count
+    uint8_t state_out=0;
+    
+    //check on neighbors, see how many are alive.
+    if(get_current_pixel_state(in_states, x-1,y)){n++;}
+    if(get_current_pixel_state(in_states, x-1,y+1)){n++;}
+    if(get_current_pixel_state(in_states, x-1,y-1)){n++;}
+    
+    if(get_current_pixel_state(in_states, x,y-1)){n++;}
+    if(get_current_pixel_state(in_states, x,y+1)){n++;}
+    
+    if(get_current_pixel_state(in_states, x+1,y)){n++;}
+    if(get_current_pixel_state(in_states, x+1,y+1)){n++;}
+    if(get_current_pixel_state(in_states, x+1,y-1)){n++;}
+    
+    //now determine if dead or alive by neighbors,
+    //these are implementing the rule's of Conway's Game of Life:
+    /* from Wikipedia
+     * Any live cell with fewer than two live neighbours dies, as if caused by under-population.
+     * Any live cell with two or three live neighbours lives on to the next generation.
+     * Any live cell with more than three live neighbours dies, as if by overcrowding.
+     * Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
+     */
+    if((n<2)){state_out=0;}
+    else if ((n<=3) && get_current_pixel_state(in_states, x, y)){state_out=1;}
+    else if ((n==3)){state_out=1;}
+    else if ((n>3)){state_out=0;}
+    
+    return state_out;
+}
+
+#if LIFE_STATE_STORAGE
+uint8_t life_step_pixel(void){
+//find all the new states and put them in the buffer
+    
+    //copy the current stuff into storage
+    
+    int8_t x=X_AXIS_LEN;
+    while(x--){
+        int8_t y=Y_AXIS_LEN;
+        while(y--){
+            if(get_new_pixel_state(fb, x, y)==1){
+                state_storage[x] |= (1<<y);
+            } else {
+                state_storage[x] &= ~(1<<y);
+            }
+        }
+    }
+    //store the difference between the two generations in diff_val
+    //to be used in finding when to reset.
+    uint8_t diff_val= get_difference(state_storage,fb);
+    
+    for(x=0;x<X_AXIS_LEN;x++){
+        //put the new values into the framebuffer
+        fb[x] = state_storage[x];
+    }
+    
+    //this one doesn't keep track, so push everything
+    life_changed = 0xffffffff;
+    
+    return diff_val;
+}
+#endif
+
+uint8_t get_difference(uint8_t a[],uint8_t b[])
+{//gets the amount of differences between two generations
+ //NOTE: get_current_pixel_state() returns the bit itself, not 1, so the
+ //"==1" tests below only ever match on row 0 and only changes in that row
+ //get counted. LOW_DIFF_THRESHOLD and MED_DIFF_THRESHOLD in life.h were
+ //tuned like this, so life_step_column() counts the same way.
+    uint8_t x_v,y_v,diff=0;
+
+    for(x_v=0; x_v < X_AXIS_LEN; x_v++)
+    {
+        for(y_v=0; y_v < Y_AXIS_LEN; y_v++)
+        {
+            //if changed from 0 to 1 or vise-versa, then increment the difference value
+            if(( (get_current_pixel_state(a,x_v,y_v)==1) && (get_current_pixel_state(b,x_v,y_v) == 0)) 
+            || ((get_current_pixel_state(a,x_v,y_v)==0) && (get_current_pixel_state(b,x_v,y_v)==1)))
+            {
+                diff++;
+            }
+        }
+    }
+    return diff;
+}
+
+//rotate a column up/down by one cell, wrapping the y axis
+#define ROT_UP(v) ((uint8_t)(((v)<<1)|((v)>>7)))
+#define ROT_DOWN(v) ((uint8_t)(((v)>>1)|((v)<<7)))
+
+//the neighbours above/below every cell of a column. without the y axis
+//wrapping, a plain shift brings dead cells in at the top and bottom.
+#if LIFE_WRAPS_Y
+#define NB_UP(v) ROT_UP(v)
+#define NB_DOWN(v) ROT_DOWN(v)
+#else
+#define NB_UP(v) ((uint8_t)((v)<<1))
+#define NB_DOWN(v) ((uint8_t)((v)>>1))
+#endif
+
+#if LIFE_TOPOLOGY == LIFE_KLEIN
+static uint8_t flip_y(uint8_t v){
+//turns a column upside down, for the columns wrapping round the x axis
+    v = (v >> 4) | (v << 4);
+    v = ((v >> 2) & 0x33) | ((v & 0x33) << 2);
+    v = ((v >> 1) & 0x55) | ((v & 0x55) << 1);
+    return v;
+}
+#endif
+
+//what's to the left of column 0 given the last column, and to the right
+//of the last column given column 0 (without LIFE_HALO)
+#if LIFE_TOPOLOGY == LIFE_PLANE
+#define LEFT_OF_FIRST(last) 0
+#define RIGHT_OF_LAST(first) 0
+#elif LIFE_TOPOLOGY == LIFE_KLEIN
+#define LEFT_OF_FIRST(last) flip_y(last)
+#define RIGHT_OF_LAST(first) flip_y(first)
+#else
+#define LEFT_OF_FIRST(last) (last)
+#define RIGHT_OF_LAST(first) (first)
+#endif
+
+//adds the 8 bit wide input v into the bit-sliced counters s0,s1,s2,
+//s2 sticks once set, so it means "4 or more".
+#define ADD_NEIGHBOR(v) do{ \
+        uint8_t c0 = s0 & (v); \
+        s0 ^= (v); \
+        s2 |= s1 & c0; \
+        s1 ^= c0; \
+    }while(0)
+
+#if LIFE_COLUMN_C
+static uint8_t life_column(uint8_t l, uint8_t c, uint8_t r){
+//works out the next state of all 8 cells of column c at once,
+//l and r are the columns to the left and right of it.
+    uint8_t s0=0, s1=0, s2=0;
+    
+    ADD_NEIGHBOR(l);
+    ADD_NEIGHBOR(NB_UP(l));
+    ADD_NEIGHBOR(NB_DOWN(l));
+    ADD_NEIGHBOR(NB_UP(c));
+    ADD_NEIGHBOR(NB_DOWN(c));
+    ADD_NEIGHBOR(r);
+    ADD_NEIGHBOR(NB_UP(r));
+    ADD_NEIGHBOR(NB_DOWN(r));
+    
+    //alive with 3 neighbors, or 2 if it was alive already
+    return s1 & ~s2 & (s0 | c);
+}
+#endif
+
+uint8_t life_step_column(void){
+//only columns next to one that changed last time can change this time,
+//the rest are left as they are.
+//the new generation is written straight over the grid, so this only has
+//to hold on to the old values of the column to the left of the one being
+//worked on, and of column 0 for when the last column wraps around to it.
+//state_storage isn't needed, so it's left out of the build (see life.h).
+//each column is only read once, which matters with LIFE_ENGINE_DISPLAY.
+//with LIFE_HALO the neighbours' columns are used at the edges instead.
+//LIFE_TOPOLOGY only changes what goes in edge, prev and the active mask
+//before the loop, and NB_UP/NB_DOWN, so the loop itself is the same.
+    uint32_t active;
+    uint8_t diff_val=0;
+    uint8_t edge, prev, cur;
+    #if !LIFE_STEP_ASM
+    uint32_t changed=0;
+    uint32_t bit;
+    uint8_t x;
+    uint8_t next;
+    #endif
+    
+    #if LIFE_HALO
+    if(!life_changed && !halo_changed){
+        //nothing moved last time, so nothing will move now
+        return 0;
+    }
+    #else
+    if(!life_changed){
+        //nothing moved last time, so nothing will move now
+        return 0;
+    }
+    #endif
+    
+    //spread the changes one column each way
+    active = life_changed | (life_changed << 1) | (life_changed >> 1);
+    #if LIFE_HALO
+    //and the neighbours' changes into the edge columns
+    if(halo_changed & 1){
+        active |= 1;
+    }
+    if(halo_changed & 2){
+        active |= ((uint32_t)1 << (X_AXIS_LEN-1));
+    }
+    halo_changed = 0;
+    #elif LIFE_TOPOLOGY != LIFE_PLANE
+    //wrapping the x axis
+    active |= (life_changed >> (X_AXIS_LEN-1)) | (life_changed << (X_AXIS_LEN-1));
+    #endif
+    
+    //edge is what's to the right of the last column,
+    //prev starts off as what's to the left of column 0
+    cur = LIFE_COL(0);
+    #if LIFE_HALO
+    edge = life_halo_right;
+    prev = life_halo_left;
+    #else
+    edge = RIGHT_OF_LAST(cur);
+    prev = LEFT_OF_FIRST(LIFE_COL(X_AXIS_LEN-1));
+    #endif
+    
+    #if LIFE_STEP_ASM
+    //the same loop as below, in life_asm.S. cur was only for edge,
+    //which LIFE_PLANE doesn't take from column 0
+    (void)cur;
+    diff_val = life_step_asm(fb, &active, ((uint16_t)edge << 8) | prev);
+    life_changed = active;
+    return diff_val;
+    #else
+    for(x=0, bit=1; x<X_AXIS_LEN; x++, bit<<=1){
+        //the column to the right hasn't been overwritten yet,
+        //except for column 0 which edge has a copy of
+        //(or the right hand neighbour's column 0 with LIFE_HALO)
+        next = (x == (X_AXIS_LEN-1)) ? edge : LIFE_COL(x+1);
+        
+        if(active & bit){
+            uint8_t n = life_column(prev, cur, next);
+            uint8_t d = n ^ cur;
+            if(d){
+                LIFE_COL_SET(x, n);
+                changed |= bit;
+                //only row 0 counts, see get_difference()
+                diff_val += (d & 1);
+            }
+        }
+        prev = cur;
+        cur = next;
+    }
+    
+    life_changed = changed;
+    return diff_val;
+    #endif
+}
+
+uint16_t life_seed_next(uint16_t state){
+//a 16 bit xorshift, never gives 0 unless it's given 0
+    state ^= state << 7;
+    state ^= state >> 9;
+    state ^= state << 8;
+    return state;
+}
+
+void life_seed(uint16_t seed){
+    uint8_t x;
+    
+    if(!seed){
+        seed = 1;
+    }
+    for(x=0; x<X_AXIS_LEN; x++){
+        seed = life_seed_next(seed);
+        LIFE_COL_SET(x, (uint8_t)seed);
+    }
+}
+
+#if LIFE_PRESCREEN
+
+static uint16_t prescreen_seed; //the seed being tried
+static uint8_t prescreen_gens; //generations it's lasted so far
+static uint8_t prescreen_state=LIFE_SEED_NEEDED;
+static struct life_stagnation prescreen_stag; //its own life_stagnant() state
+
+void life_prescreen_start(uint16_t seed){
+    uint8_t x;
+    
+    if(!seed){
+        seed = 1; //0 would only ever give an empty grid
+    }
+    prescreen_seed = seed;
+    for(x=0; x<X_AXIS_LEN; x++){
+        seed = life_seed_next(seed);
+        state_storage[x] = (uint8_t)seed;
+    }
+    prescreen_gens = 0;
+    stagnant_clear(&prescreen_stag);
+    prescreen_state = LIFE_SEED_TRYING;
+}
+
+uint8_t life_prescreen(void){
+//the same as life_step_column() on state_storage, but every column every
+//time, as this doesn't keep track of which ones changed
+    uint8_t x;
+    uint8_t diff_val=0;
+    uint8_t edge, prev, cur, next;
+    uint16_t pop=0;
+    
+    if(prescreen_state != LIFE_SEED_TRYING){
+        return prescreen_state;
+    }
+    
+    cur = state_storage[0];
+    edge = RIGHT_OF_LAST(cur);
+    prev = LEFT_OF_FIRST(state_storage[X_AXIS_LEN-1]);
+    for(x=0; x<X_AXIS_LEN; x++){
+        next = (x == (X_AXIS_LEN-1)) ? edge : state_storage[x+1];
+        state_storage[x] = life_column(prev, cur, next);
+        //only row 0 counts, see get_difference()
+        diff_val += ((state_storage[x] ^ cur) & 1);
+        #if LIFE_STAGNANT != LIFE_STAGNANT_COUNTS
+        pop += col_pop(state_storage[x]);
+        #endif
+        prev = cur;
+        cur = next;
+    }
+    
+    if(stagnant(&prescreen_stag, diff_val, pop)){
+        prescreen_state = LIFE_SEED_NEEDED;
+    }
+    else if(++prescreen_gens >= LIFE_PRESCREEN_GENS){
+        prescreen_state = LIFE_SEED_GOOD;
+    }
+    return prescreen_state;
+}
+
+uint16_t life_prescreen_take(void){
+//makes the seed's grid again, state_storage has moved on from it
+    if(prescreen_state != LIFE_SEED_GOOD){
+        return 0;
+    }
+    life_seed(prescreen_seed);
+    prescreen_state = LIFE_SEED_NEEDED;
+    return prescreen_seed; //never 0, see life_prescreen_start()
+}
+
+#endif
+
+#if LIFE_SHIP_CHECK
+
+//a kept cell moved over by dx and dy, wrapping both ways
+#define SHIP_CELL_X(c) ((c) >> 3)
+#define SHIP_CELL_Y(c) ((c) & (Y_AXIS_LEN-1))
+
+static uint8_t ship_shifted(uint8_t dx, uint8_t dy){
+//returns 1 if every cell kept in life_ship, moved over by dx and dy, is
+//alive in fb. there are as many of them as there are in fb, so then
+//that's the whole grid.
+    uint8_t i, c;
+    
+    for(i=0; i<life_ship.count; i++){
+        c = life_ship.cells[i];
+        if(!(fb[(SHIP_CELL_X(c) + dx) & (X_AXIS_LEN-1)]
+             & (1 << ((SHIP_CELL_Y(c) + dy) & (Y_AXIS_LEN-1))))){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+uint8_t life_translated(void){
+    uint8_t x, y, c;
+    uint8_t moved=0;
+    uint16_t pop=0;
+    
+    if(++life_ship.phase < LIFE_SHIP_PERIOD){
+        return 0;
+    }
+    life_ship.phase=0;
+    
+    for(x=0; x<X_AXIS_LEN; x++){
+        pop += col_pop(fb[x]);
+    }
+    
+    //the first kept cell has to have gone to one of fb's live cells, so
+    //those are the only moves worth trying
+    if(pop && (pop == life_ship.count)){
+        c = life_ship.cells[0];
+        for(x=0; (x<X_AXIS_LEN) && !moved; x++){
+            for(y=0; y<Y_AXIS_LEN; y++){
+                uint8_t dx = (x - SHIP_CELL_X(c)) & (X_AXIS_LEN-1);
+                uint8_t dy = (y - SHIP_CELL_Y(c)) & (Y_AXIS_LEN-1);
+                if(!(fb[x] & (1<<y)) || (!dx && !dy)){
+                    continue; //not moved, life_stagnant() deals with those
+                }
+                if(ship_shifted(dx, dy)){
+                    moved=1;
+                    break;
+                }
+            }
+        }
+    }
+    
+    //keep this one's cells to compare with next time, if there's room
+    life_ship.count = LIFE_SHIP_NONE;
+    if(pop <= LIFE_SHIP_CELLS){
+        c=0;
+        for(x=0; x<X_AXIS_LEN; x++){
+            for(y=0; y<Y_AXIS_LEN; y++){
+                if(fb[x] & (1<<y)){
+                    life_ship.cells[c++] = (x << 3) | y;
+                }
+            }
+        }
+        life_ship.count = c;
+    }
+    
+    return moved;
+}
+
+void life_translated_reset(void){
+    life_ship.phase=0;
+    life_ship.count=LIFE_SHIP_NONE;
+}
+
+#endif
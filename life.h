@@ -0,0 +1,342 @@
+//the Game of Life engine, kept apart from the hardware stuff in main.c
+//so it only needs <stdint.h>
+
+
+//header file with game of life stuff
+
+#ifndef LIFE_H
+#define LIFE_H
+
+//life_asm.S includes this too, for the options up to the C declarations
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+#endif
+
+#define X_AXIS_LEN 32 //length of x axis
+#define Y_AXIS_LEN 8 //length of y axis
+
+//how life_stagnant() decides the grid has got boring
+#define LIFE_STAGNANT_COUNTS 0 //counts generations with a low or medium
+                               //difference, the original way
+#define LIFE_STAGNANT_EMA 1 //moving averages and variances of the
+                            //population and the difference, see below
+
+//EMA resets far fewer grids that are still going, so it's the default.
+//its averages take 11 bytes more RAM and about 300 bytes more flash than
+//the counts, so the variants that are already full build with the counts
+//(STAGNANT_COUNTS in the Makefile)
+#ifndef LIFE_STAGNANT
+#define LIFE_STAGNANT LIFE_STAGNANT_EMA
+#endif
+
+#define LOW_DIFF_THRESHOLD 42 //threshold of how many generations can pass
+                                //with a low difference betweem each other
+                                //before reset.
+#define MED_DIFF_THRESHOLD 196 //same as above but for medium difference.
+
+//for LIFE_STAGNANT_EMA. every generation the population and the difference
+//(each added up over the last two generations, so period 2 oscillators
+//come out flat) go into exponential moving averages, and how far they are
+//from them, squared, into more of them, their variances. it resets when:
+//
+//  both variances have been low for LIFE_QUIET_GENS generations, the grid
+//  has settled into still lifes and period 2 oscillators, however big, or
+//  the population's variance has stayed within about half of its own
+//  moving average for LIFE_STEADY_GENS, which is what a longer cycle
+//  looks like. a grid that's still going somewhere, even slowly, keeps
+//  moving away from its averages now and then.
+//
+//all shifts and adds, the ATtiny26 has no divide. the defaults come from
+//`make stagnation`, see host/stagnation.c.
+#ifndef LIFE_EMA_SHIFT
+#define LIFE_EMA_SHIFT 3 //the averages move 1/8th of the way each generation
+#endif
+#ifndef LIFE_POP_VAR_MAX
+#define LIFE_POP_VAR_MAX 256 //population variance that still counts as
+                             //settled, in 1/16ths of a cell squared
+#endif
+#ifndef LIFE_DIFF_VAR_MAX
+#define LIFE_DIFF_VAR_MAX 16 //same for the difference
+#endif
+#ifndef LIFE_QUIET_GENS
+#define LIFE_QUIET_GENS 16
+#endif
+#ifndef LIFE_STEADY_GENS
+#define LIFE_STEADY_GENS 160
+#endif
+#if (LIFE_QUIET_GENS > 254) || (LIFE_STEADY_GENS > 255)
+#error "LIFE_QUIET_GENS and LIFE_STEADY_GENS have to fit in a byte, with 0xff spare for LIFE_QUIET_GENS"
+#endif
+
+//the engines life_step() can be built with
+#define LIFE_ENGINE_PIXEL 0 //the original one, cell by cell, kept as reference
+#define LIFE_ENGINE_COLUMN 1 //a whole column at a time, only near changes
+#define LIFE_ENGINE_DISPLAY 2 //same as above, but the grid is kept in the
+                              //display's own RAM rather than in fb
+
+#ifndef LIFE_ENGINE
+#define LIFE_ENGINE LIFE_ENGINE_COLUMN
+#endif
+
+//what happens at the edges of the grid
+#define LIFE_TORUS 0 //wraps both ways, like it always has
+#define LIFE_PLANE 1 //no wrapping, cells past the edges are always dead
+#define LIFE_CYLINDER 2 //wraps left to right only, dead above and below
+#define LIFE_KLEIN 3 //wraps both ways, but upside down going off the left
+                     //or right edge, a Klein bottle
+
+#ifndef LIFE_TOPOLOGY
+#define LIFE_TOPOLOGY LIFE_TORUS
+#endif
+
+#define LIFE_WRAPS_Y ((LIFE_TOPOLOGY == LIFE_TORUS) || (LIFE_TOPOLOGY == LIFE_KLEIN))
+
+//keeps the grid and life_stag in .noinit rather than .bss on
+//the AVR, so they're still there after a watchdog reset and main.c can
+//carry on with them (see DO_YOU_WANT_TO_USE_WATCHDOG there). that means
+//they're junk at power on until they've been set.
+#ifndef LIFE_WARM_RESTART
+#define LIFE_WARM_RESTART 0
+#endif
+
+#if LIFE_WARM_RESTART && defined(__AVR__)
+#define LIFE_NOINIT __attribute__((section(".noinit")))
+#else
+#define LIFE_NOINIT
+#endif
+
+//with LIFE_ASM=1 the loop in life_step_column() is the one in life_asm.S
+//rather than the C one, with everything it needs kept in registers. only
+//on the AVR, the PC builds use the C, unless LIFE_ASM_SIM=1 too, where
+//the program has to supply a life_step_asm() of its own. the equivalence
+//check does, running life_asm.S in host/avr_sim.c's AVR.
+#ifndef LIFE_ASM
+#define LIFE_ASM 0
+#endif
+#ifndef LIFE_ASM_SIM
+#define LIFE_ASM_SIM 0
+#endif
+#if LIFE_ASM && (defined(__AVR__) || LIFE_ASM_SIM)
+#define LIFE_STEP_ASM 1
+#else
+#define LIFE_STEP_ASM 0
+#endif
+
+#if LIFE_ASM && (LIFE_ENGINE != LIFE_ENGINE_COLUMN)
+#error "LIFE_ASM needs LIFE_ENGINE_COLUMN, it works on fb"
+#endif
+
+#ifndef __ASSEMBLER__
+
+extern uint8_t fb[X_AXIS_LEN];      /* framebuffer */
+
+//state_storage, a second grid, is only there for the engines that need
+//it: life_step_pixel() and LIFE_PRESCREEN. the PC builds always have it,
+//as life_step_pixel() is what the others get checked against there.
+#if (LIFE_ENGINE == LIFE_ENGINE_PIXEL) || LIFE_PRESCREEN || !defined(__AVR__)
+#define LIFE_STATE_STORAGE 1
+extern uint8_t state_storage[X_AXIS_LEN];
+#else
+#define LIFE_STATE_STORAGE 0
+#endif
+
+//for a wall of several boards side by side (see link.h), the columns to
+//the left of column 0 and the right of the last one are the neighbouring
+//boards' edge columns, rather than wrapping around to this grid's own.
+//only the column engine can do this, and the top and bottom are left to
+//LIFE_TOPOLOGY, so it has to be LIFE_TORUS or LIFE_CYLINDER.
+#ifndef LIFE_HALO
+#define LIFE_HALO 0
+#endif
+
+#if LIFE_HALO
+#if LIFE_ENGINE == LIFE_ENGINE_PIXEL
+#error "LIFE_HALO needs the column engine"
+#endif
+#if (LIFE_TOPOLOGY == LIFE_PLANE) || (LIFE_TOPOLOGY == LIFE_KLEIN)
+#error "LIFE_HALO decides the left and right edges, use LIFE_TORUS or LIFE_CYLINDER"
+#endif
+extern uint8_t life_halo_left; //last column of the board on the left
+extern uint8_t life_halo_right; //column 0 of the board on the right
+
+//call with the neighbours' edge columns before each life_step()
+void life_set_halo(uint8_t left, uint8_t right);
+#endif
+
+//bit x is set if column x of fb changed in the last generation,
+//display_push() only needs to send those.
+extern uint32_t life_changed;
+
+//call after writing to fb directly, so every column gets looked at
+void life_all_changed(void);
+
+//both of these replace fb with its next generation and return the
+//difference between the two, counted the same way as get_difference().
+#if LIFE_STATE_STORAGE
+uint8_t life_step_pixel(void);
+#endif
+uint8_t life_step_column(void);
+
+#if LIFE_ENGINE == LIFE_ENGINE_PIXEL
+#define life_step() life_step_pixel()
+#else
+#define life_step() life_step_column()
+#endif
+
+//how the column engine gets at the grid, one column (8 cells) at a time.
+//with LIFE_ENGINE_DISPLAY whatever drives the display has to provide
+//these, fb isn't used at all then and the grid doesn't take any RAM.
+#if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+uint8_t life_col_read(uint8_t x);
+void life_col_write(uint8_t x, uint8_t col);
+#define LIFE_COL(x) life_col_read(x)
+#define LIFE_COL_SET(x,v) life_col_write((x),(v))
+#else
+#define LIFE_COL(x) (fb[(x)])
+#define LIFE_COL_SET(x,v) (fb[(x)] = (v))
+#endif
+
+//everything life_stagnant() keeps between generations
+struct life_stagnation {
+#if LIFE_STAGNANT == LIFE_STAGNANT_COUNTS
+    uint8_t low; //generations with a low difference, less the busy ones
+    uint16_t med; //same for a medium difference
+#else
+    int16_t pop; //population average, with 4 fraction bits
+    uint16_t pop_var; //its variance, also in 1/16ths
+    int16_t diff; //same for the difference
+    uint16_t diff_var;
+    uint16_t pop_var_avg; //moving average of pop_var
+    uint8_t quiet; //generations in a row both variances have been low
+    uint8_t steady; //generations in a row pop_var has been near its average
+    uint8_t last_pop; //last generation's, up to 255
+    uint8_t last_diff;
+#endif
+};
+
+extern struct life_stagnation life_stag;
+
+//call along with life_all_changed() for a new grid
+void life_stagnant_clear(void);
+
+//keeps track of boring generations from the difference life_step()
+//returned (and with LIFE_STAGNANT_EMA the population), and returns 1 when
+//there have been too many of them and the grid should be reset.
+uint8_t life_stagnant(uint8_t diff_val);
+
+//spots grids that are the same as a few generations ago but moved over
+//(wrapping around), like a lone glider going round and round forever,
+//which life_stagnant() above takes a long time to catch. every
+//LIFE_SHIP_PERIOD generations it keeps where the live cells are to compare
+//against, as long as there are no more than LIFE_SHIP_CELLS of them (a
+//ship or two), rather than a copy of the whole grid. it isn't available
+//with LIFE_ENGINE_DISPLAY, and only ships on a torus keep their shape
+//going round, so that's all it does. it's only there when asked for (the
+//ship_check variant), the ATtiny26 hasn't got the RAM for it alongside
+//everything else.
+#ifndef LIFE_SHIP_CHECK
+#define LIFE_SHIP_CHECK 0
+#endif
+#if LIFE_SHIP_CHECK && ((LIFE_ENGINE != LIFE_ENGINE_COLUMN) || LIFE_HALO \
+    || (LIFE_TOPOLOGY != LIFE_TORUS) || LIFE_PRESCREEN)
+#error "LIFE_SHIP_CHECK needs the column engine on a torus, without LIFE_HALO or LIFE_PRESCREEN"
+#endif
+#define LIFE_SHIP_PERIOD 4 //gliders and lightweight spaceships repeat every 4
+#define LIFE_SHIP_CELLS 12 //a lightweight spaceship has up to 12 live cells
+
+#if LIFE_SHIP_CHECK
+//what life_translated() keeps between generations
+struct life_ship {
+    uint8_t cells[LIFE_SHIP_CELLS]; //live cells LIFE_SHIP_PERIOD ago, x<<3|y
+    uint8_t count; //how many, or LIFE_SHIP_NONE
+    uint8_t phase; //generations since cells were kept
+};
+#define LIFE_SHIP_NONE 0xff //too many cells, or nothing kept yet
+
+extern struct life_ship life_ship;
+
+//call once a generation, after life_step(). returns 1 if the grid is the
+//one from LIFE_SHIP_PERIOD generations ago, shifted in x and/or y.
+uint8_t life_translated(void);
+
+//call after writing a new grid to fb, so it isn't compared with the old one
+void life_translated_reset(void);
+#endif
+
+//the next state of the seed's random number generator, the low byte of
+//each one is a column of the grid, starting with column 0
+uint16_t life_seed_next(uint16_t state);
+
+//puts the grid made from seed in with LIFE_COL_SET(), like a new random
+//grid (it still needs life_all_changed() and so on). the same seed always
+//gives the same grid, so a logged one can be looked at again on a PC.
+//0 gets made 1, as it would only ever give an empty grid.
+void life_seed(uint16_t seed);
+
+//tries out new seeds off screen while the current grid is still going,
+//so the next reset can use one that doesn't freeze or die straight away.
+//a seed is run on state_storage (which the column engine doesn't have
+//otherwise) and kept if life_stagnant() wouldn't have asked for a reset
+//within LIFE_PRESCREEN_GENS generations. there isn't the RAM for this and
+//the ship check on an ATtiny26, so that gets left out unless asked for.
+#ifndef LIFE_PRESCREEN
+#define LIFE_PRESCREEN 0
+#endif
+
+#if LIFE_PRESCREEN
+#if (LIFE_ENGINE == LIFE_ENGINE_PIXEL) || LIFE_HALO
+#error "LIFE_PRESCREEN needs the column engine, and the whole grid on this board"
+#endif
+#if LIFE_STAGNANT == LIFE_STAGNANT_COUNTS
+#define LIFE_PRESCREEN_GENS 64 //longer than LOW_DIFF_THRESHOLD, so soups that
+                               //freeze early get caught
+#else
+#define LIFE_PRESCREEN_GENS 128 //the averages take a while to settle, so
+                                //even a soup that freezes straight away
+                                //isn't reset for a few dozen generations
+#endif
+
+//what life_prescreen() returns
+#define LIFE_SEED_TRYING 0 //still running it
+#define LIFE_SEED_GOOD 1 //lasted, it's waiting for the next reset
+#define LIFE_SEED_NEEDED 2 //didn't last (or there isn't one yet), call
+                           //life_prescreen_start() with another
+
+//starts trying out seed
+void life_prescreen_start(uint16_t seed);
+
+//runs one generation of the seed being tried, call whenever there's time
+uint8_t life_prescreen(void);
+
+//if there's a good seed waiting, puts it into the grid with life_seed()
+//and returns it, then life_prescreen() will want a new one. returns 0 if
+//there isn't one yet.
+uint16_t life_prescreen_take(void);
+#endif
+
+#if LIFE_WARM_RESTART
+//adds the grid (from LIFE_COL()) and life_stag onto sum,
+//for checking that they made it through a reset
+uint16_t life_state_sum(uint16_t sum);
+#endif
+
+//how many cells of the grid (from LIFE_COL()) are alive, 0-256
+uint16_t life_population(void);
+
+//stuff for the reference engine
+uint8_t get_new_pixel_state(uint8_t in_states[], int8_t x, int8_t y);
+uint8_t get_current_pixel_state(uint8_t in[], int8_t x,int8_t y); 
+uint8_t get_difference(uint8_t a[],uint8_t b[]);
+
+#if LIFE_STEP_ASM
+//the loop of life_step_column() in life_asm.S. it goes through the 32
+//columns of grid, with the low byte of edges as the column to the left of
+//column 0 and the high byte as the one to the right of the last, working
+//out only the columns set in *mask. *mask gets the columns that changed,
+//and it returns the difference counted like get_difference().
+uint8_t life_step_asm(uint8_t *grid, uint32_t *mask, uint16_t edges);
+#endif
+
+#endif //__ASSEMBLER__
+
+#endif
@@ -0,0 +1,39 @@
+//the link between boards in a wall of several 32x8 displays
+
+//the functions that don't care about pins, see link_avr.c for those
+
+#include "link.h"
+
+void link_begin(struct link_state *l, uint8_t left_col, uint8_t right_col){
+    l->tx_left = left_col;
+    l->tx_right = right_col;
+    l->rx_left = 0;
+    l->rx_right = 0;
+    l->bits = LINK_BITS;
+}
+
+uint8_t link_clock_low(struct link_state *l){
+    uint8_t out = 0;
+    //MSB first
+    if(l->tx_left & 0x80){
+        out |= LINK_LEFT;
+    }
+    if(l->tx_right & 0x80){
+        out |= LINK_RIGHT;
+    }
+    l->tx_left <<= 1;
+    l->tx_right <<= 1;
+    return out;
+}
+
+void link_clock_high(struct link_state *l, uint8_t in){
+    l->rx_left <<= 1;
+    l->rx_right <<= 1;
+    if(in & LINK_LEFT){
+        l->rx_left |= 1;
+    }
+    if(in & LINK_RIGHT){
+        l->rx_right |= 1;
+    }
+    l->bits--;
+}
@@ -0,0 +1,84 @@
+//the link between boards in a wall of several 32x8 displays side by side,
+//all running one big Game of Life. each board swaps its edge columns with
+//the boards either side of it every generation (the "halo", see LIFE_HALO
+//in life.h), and one master board sets the pace for all of them.
+//
+//wiring, with the last board's right going back round to the first's left:
+//
+//   master           slave            slave
+//  TX_R ---------> RX_L  TX_R -------> RX_L  ...
+//  RX_R <--------- TX_L  RX_R <------- TX_L  ...
+//  CLK ------------ CLK ------------- CLK (master drives, slaves listen)
+//
+//each generation the master holds CLK low for LINK_SYNC_MS, which every
+//slave sees from its main loop, then clocks LINK_BITS bits on it. on each
+//falling edge every board puts a bit of its column 0 on TX_L and of its
+//last column on TX_R, and on each rising edge it reads RX_L and RX_R.
+//after that they all work out the next generation at the same time.
+//
+//a slave only takes CLK being low for at least LINK_SYNC_MIN_US as the
+//sync, which a data bit's LINK_HALF_US never is, so one that gave up part
+//way through an exchange waits for the next real sync rather than getting
+//out of step with the rest.
+//
+//the wall is one grid, so only the master decides when it gets reset. it
+//holds CLK low for LINK_RESET_MS instead of LINK_SYNC_MS to say so, and
+//every board resets its part at the end of that generation.
+
+
+//header file with the link stuff
+
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+
+#define LINK_BITS 8 //one column each way
+#define LINK_SYNC_MS 10 //longer than a slave's main loop takes
+#define LINK_HALF_US 50 //half a CLK period, slaves poll for the edges
+#define LINK_TIMEOUT_US 2000 //a slave gives up waiting for an edge after this
+#define LINK_SYNC_MIN_US 1000 //CLK low for this long is the sync, not a bit
+#define LINK_RESET_MS 40 //sync pulse that says the wall is being reset, a
+                         //slave that sees it late still sees it as longer
+                         //than twice LINK_SYNC_MS
+
+//time the link takes each generation
+#define LINK_TICK_US ((1000UL * LINK_SYNC_MS) + LINK_HALF_US + (2UL * LINK_BITS * LINK_HALF_US))
+
+//the part that doesn't care about pins, so host/wall_sim.c can run it
+struct link_state {
+    uint8_t tx_left; //column going to the board on the left
+    uint8_t tx_right; //column going to the board on the right
+    uint8_t rx_left; //column coming from the board on the left
+    uint8_t rx_right; //column coming from the board on the right
+    uint8_t bits; //bits left to go
+};
+
+//the two lines' levels as passed to and from the functions below
+#define LINK_LEFT (1<<0)
+#define LINK_RIGHT (1<<1)
+
+void link_begin(struct link_state *l, uint8_t left_col, uint8_t right_col);
+
+//on a falling edge of CLK, returns what to put on TX_L and TX_R
+uint8_t link_clock_low(struct link_state *l);
+
+//on a rising edge of CLK, with what was read from RX_L and RX_R
+void link_clock_high(struct link_state *l, uint8_t in);
+
+//what link_exchange() returns
+#define LINK_DONE (1<<0) //the columns were swapped, otherwise the master
+                         //went quiet part way and the old halo is kept
+#define LINK_RESET (1<<1) //the master says the wall is being reset
+
+//the AVR side, in link_avr.c. link_exchange() does one generation's
+//swap and hands the neighbours' columns to life_set_halo(). on the master
+//it makes the sync pulse (a long one if reset is set) and clocks, on a
+//slave call it once link_sync_seen() says the master has started one.
+#ifdef __AVR__
+void init_link(void);
+uint8_t link_sync_seen(void);
+uint8_t link_exchange(uint8_t reset);
+#endif
+
+#endif
@@ -0,0 +1,179 @@
+//the link between boards in a wall of several 32x8 displays
+
+//the pin side of it, see link.h
+
+#include "link.h"
+#include "life.h"
+
+#include <avr/io.h>
+#include <util/delay.h>
+
+//only wall builds have the halo the link fills in (main.c checks that),
+//the rest leave all of this out
+#if LIFE_HALO
+
+//none of these are free on the original board, this uses the button pin
+//for CLK and the 7 segment display's pins for the rest, so a wall board
+//is built without either (see the wall_master/wall_slave variants).
+#define LINK_CLK_BIT 6
+#define LINK_CLK_DDR DDRB
+#define LINK_CLK_PORT PORTB
+#define LINK_CLK_PIN PINB
+
+#define LINK_DDR DDRA
+#define LINK_PORT PORTA
+#define LINK_PIN PINA
+#define LINK_TX_L (1<<0)
+#define LINK_TX_R (1<<1)
+#define LINK_RX_L (1<<2)
+#define LINK_RX_R (1<<3)
+
+#ifndef LINK_MASTER
+#define LINK_MASTER 0
+#endif
+
+#define CLK_IS_LOW() bit_is_clear(LINK_CLK_PIN, LINK_CLK_BIT)
+
+void init_link(void){
+    LINK_DDR |= (LINK_TX_L | LINK_TX_R);
+    LINK_DDR &= ~(LINK_RX_L | LINK_RX_R);
+    LINK_PORT |= (LINK_RX_L | LINK_RX_R); //pullups, in case of no neighbour
+    
+    //CLK idles high, driven by the master, pulled up on the slaves
+    LINK_CLK_PORT |= (1<<LINK_CLK_BIT);
+    #if LINK_MASTER
+    LINK_CLK_DDR |= (1<<LINK_CLK_BIT);
+    #else
+    LINK_CLK_DDR &= ~(1<<LINK_CLK_BIT);
+    #endif
+}
+
+uint8_t link_sync_seen(void){
+    #if LINK_MASTER
+    return 0;
+    #else
+    //a data bit's low is over long before LINK_SYNC_MIN_US
+    uint8_t t = LINK_SYNC_MIN_US / 10;
+    while(CLK_IS_LOW()){
+        if(!t--){
+            return 1;
+        }
+        _delay_us(10);
+    }
+    return 0;
+    #endif
+}
+
+static void link_out(uint8_t out){
+    if(out & LINK_LEFT){
+        LINK_PORT |= LINK_TX_L;
+    } else {
+        LINK_PORT &= ~LINK_TX_L;
+    }
+    if(out & LINK_RIGHT){
+        LINK_PORT |= LINK_TX_R;
+    } else {
+        LINK_PORT &= ~LINK_TX_R;
+    }
+}
+
+static uint8_t link_in(void){
+    uint8_t in = 0;
+    uint8_t pins = LINK_PIN;
+    if(pins & LINK_RX_L){
+        in |= LINK_LEFT;
+    }
+    if(pins & LINK_RX_R){
+        in |= LINK_RIGHT;
+    }
+    return in;
+}
+
+#if !LINK_MASTER
+static uint8_t wait_clk(uint8_t want_low, uint16_t t){
+//waits up to about t us for CLK to go low (or high), returns 0 if it doesn't
+    while((CLK_IS_LOW() ? 1 : 0) != want_low){
+        if(!t--){
+            return 0;
+        }
+        _delay_us(1);
+    }
+    return 1;
+}
+
+static uint16_t sync_rest(void){
+//waits for the end of the sync pulse, returns about how long that took in
+//10us steps, or 0 if CLK is stuck low
+    uint16_t n = 1;
+    while(CLK_IS_LOW()){
+        if(++n > (100U * LINK_RESET_MS) + (LINK_TIMEOUT_US / 10)){
+            return 0;
+        }
+        _delay_us(10);
+    }
+    return n;
+}
+#endif
+
+uint8_t link_exchange(uint8_t reset){
+//swaps edge columns with both neighbours, see LINK_DONE and LINK_RESET
+//for what it returns. reset only matters on the master.
+    struct link_state l;
+    uint8_t ret = 0;
+    
+    link_begin(&l, LIFE_COL(0), LIFE_COL(X_AXIS_LEN-1));
+    
+    #if LINK_MASTER
+    //long enough low for every slave to notice, longer for a reset
+    LINK_CLK_PORT &= ~(1<<LINK_CLK_BIT);
+    if(reset){
+        _delay_ms(LINK_RESET_MS);
+        ret = LINK_RESET;
+    } else {
+        _delay_ms(LINK_SYNC_MS);
+    }
+    LINK_CLK_PORT |= (1<<LINK_CLK_BIT);
+    _delay_us(LINK_HALF_US);
+    
+    while(l.bits){
+        LINK_CLK_PORT &= ~(1<<LINK_CLK_BIT);
+        link_out(link_clock_low(&l));
+        _delay_us(LINK_HALF_US);
+        LINK_CLK_PORT |= (1<<LINK_CLK_BIT);
+        link_clock_high(&l, link_in());
+        _delay_us(LINK_HALF_US);
+    }
+    #else
+    (void)reset;
+    //the sync pulse has been going for LINK_SYNC_MIN_US at least (see
+    //link_sync_seen()), wait for the end of it. even seen as late as a
+    //main loop can be, a reset's is still longer than twice a normal one.
+    {
+        uint16_t n = sync_rest();
+        if(!n){
+            return 0;
+        }
+        if(n + (LINK_SYNC_MIN_US / 10) > 200U * LINK_SYNC_MS){
+            ret = LINK_RESET;
+        }
+    }
+    //the reset is still on if the columns don't make it, a slave that
+    //missed it would be a different grid from the rest
+    while(l.bits){
+        if(!wait_clk(1, LINK_TIMEOUT_US)){
+            return ret;
+        }
+        link_out(link_clock_low(&l));
+        if(!wait_clk(0, LINK_TIMEOUT_US)){
+            return ret;
+        }
+        link_clock_high(&l, link_in());
+    }
+    #endif
+    
+    //the left neighbour's last column is to our left and so on
+    life_set_halo(l.rx_left, l.rx_right);
+    return ret | LINK_DONE;
+}
+
+#endif
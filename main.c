@@ -3,139 +3,614 @@
 //This is controlled by an AVR ATtiny26 mcu
 //code written by Ethan Durrant [emdarcher]
 
-//some functions are based on code from this site:
-// http://www.daqq.eu/?p=250
-// which was an implementation of Conway's Game of Life
-// on a 20x4 character LCD using an ATtiny2313 mcu.
+//the Game of Life itself is in life.c
 
 #include <avr/io.h>
-#include <stdlib.h>
 #include <util/delay.h>
 #include <avr/interrupt.h>
 #include <avr/eeprom.h>
 #include <avr/pgmspace.h>
+#include <avr/wdt.h>
 
 #include "ht1632c.h"
+#include "display.h"
 #include "seven_segs.h"
+#include "button.h"
+#include "life.h"
+#include "stack_check.h"
+#include "link.h"
+#include "stream.h"
+#include "telemetry.h"
+#include "runlog.h"
+#include "sched.h"
+
+//the options below can also be set from the Makefile, which is how the
+//build variants there are made, so each one is only a default.
+
+#ifndef DO_YOU_WANT_BUTTON
+#define DO_YOU_WANT_BUTTON 1  //set this if you want to use the button on PB6
+                                //short press: reset, long press: change speed,
+                                //double press: pause/resume
+#endif
+
+#ifndef DO_YOU_WANT_TELEMETRY
+#define DO_YOU_WANT_TELEMETRY 0 //set this to have a long press go through
+                                //readouts on the 7 segment displays instead
+                                //of the speeds, see telemetry.h
+#endif
+
+#ifndef DO_YOU_WANT_TO_USE_WATCHDOG
+#define DO_YOU_WANT_TO_USE_WATCHDOG 0 //set if you want to use watchdog
+#endif
+//with LIFE_WARM_RESTART=1 as well (see life.h), a watchdog reset carries
+//on with the same grid and generation count rather than starting again
 
-#define X_AXIS_LEN 32 //length of x axis
-#define Y_AXIS_LEN 8 //length of y axis
+#if LIFE_WARM_RESTART && !DO_YOU_WANT_TO_USE_WATCHDOG
+#error "LIFE_WARM_RESTART is only for coming back from a watchdog reset"
+#endif
 
-#define BUTTON_BIT 6 //bit number on BUTTON_PORT to be used for button
-#define BUTTON_DDR DDRB //DDRx for BUTTON_PORT
-#define BUTTON_PORT PORTB //PORTx that the button is connected to
-#define BUTTON_PIN PINB //PINx for the port the button is connected to
+#ifndef DO_YOU_WANT_GEN_OVERFLOW_RESET
+#define DO_YOU_WANT_GEN_OVERFLOW_RESET 0 //set this to reset the grid when
+                                //generation_count reaches GEN_OVERFLOW_LIMIT
+#endif
+#define GEN_OVERFLOW_LIMIT 1000
 
-#define DO_YOU_WANT_BUTTON_INT0 1  //set this if you want to use external
-                                    //interrupt INT0 on PB6 for the button.
+#define GEN_TICKS 64 //timer1 overflows per generation, 64*8.192ms = 0.524s
 
-#define LOW_DIFF_THRESHOLD 42 //threshold of how many generations can pass
-                                //with a low difference betweem each other
-                                //before reset.
-#define MED_DIFF_THRESHOLD 196 //same as above but for medium difference.
+#ifndef DO_YOU_WANT_STACK_CHECK
+#define DO_YOU_WANT_STACK_CHECK 1 //set this to keep track of how much stack
+                                //has been used, and show 'E' on the 7 segment
+                                //displays if it comes within STACK_MIN_FREE
+                                //bytes of the variables.
+#endif
+#define STACK_MIN_FREE 4
+
+#ifndef DO_YOU_WANT_SEVEN_SEGS
+#define DO_YOU_WANT_SEVEN_SEGS 1 //set this if you have the 7 segment
+                                //displays showing the generation count
+#endif
+
+#ifndef DO_YOU_WANT_LINK
+#define DO_YOU_WANT_LINK 0 //set this to make the board part of a wall of
+                            //several boards running one big Game of Life,
+                            //see link.h. set LINK_MASTER on one of them.
+#endif
+#ifndef LINK_MASTER
+#define LINK_MASTER 0
+#endif
+
+#ifndef DO_YOU_WANT_STREAM
+#define DO_YOU_WANT_STREAM 0 //set this to show frames sent from another
+                            //computer instead of the Game of Life, see
+                            //stream.h
+#endif
 
+#ifndef DO_YOU_WANT_RUN_LOG
+#define DO_YOU_WANT_RUN_LOG 0 //set this to keep a record of every grid
+                            //(how long it lasted, why it was reset, its
+                            //seed) in the EEPROM, see runlog.h
+#endif
+
+#ifndef DO_YOU_WANT_SCHEDULER
+#define DO_YOU_WANT_SCHEDULER 0 //set this to run the main loop as a table of
+                            //tasks, with the timer1 ISR only counting ticks,
+                            //see sched.h
+#endif
+
+#ifndef DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM
 #define DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM 1 //set this to "1" if you
                                 //want the ADC6 input used for adjusting
                                 //the PWM/brightness setting of the ht1632c
+#endif
 
-uint8_t fb[X_AXIS_LEN];      /* framebuffer */
-uint8_t state_storage[X_AXIS_LEN]; //area to store pixel states
+#if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+//the grid is read back out of the ht1632c, so it needs the RD line
+#if DISPLAY_BACKEND != DISPLAY_HT1632C
+#error "LIFE_ENGINE_DISPLAY keeps the grid in the ht1632c, DISPLAY_BACKEND has to be DISPLAY_HT1632C"
+#endif
+#ifndef HT1632C_RD_BIT
+#error "LIFE_ENGINE_DISPLAY needs HT1632C_RD_BIT set in the Makefile"
+#endif
+#if DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM && !defined(HT1632C_RD_PORT) && (HT1632C_RD_BIT == 7)
+#error "RD on PA7 can't be used along with the ADC6 brightness input"
+#endif
+#endif
 
-volatile uint8_t update_gen_flag = 0;
+#if DO_YOU_WANT_LINK
+//the link uses the button's and 7 segment display's pins
+#if !LIFE_HALO || DO_YOU_WANT_BUTTON || DO_YOU_WANT_SEVEN_SEGS
+#error "DO_YOU_WANT_LINK needs LIFE_HALO=1, DO_YOU_WANT_BUTTON=0 and DO_YOU_WANT_SEVEN_SEGS=0"
+#endif
+#endif
+
+#if DO_YOU_WANT_STREAM
+//the USI pins are the 7 segment display's, and the frames go in fb.
+//its loop only shows frames, so nothing would act on the button
+#if DO_YOU_WANT_SEVEN_SEGS || DO_YOU_WANT_LINK || DO_YOU_WANT_BUTTON
+#error "DO_YOU_WANT_STREAM needs DO_YOU_WANT_SEVEN_SEGS=0, DO_YOU_WANT_LINK=0 and DO_YOU_WANT_BUTTON=0"
+#endif
+#if (LIFE_ENGINE == LIFE_ENGINE_DISPLAY) || LIFE_WARM_RESTART
+#error "DO_YOU_WANT_STREAM doesn't go with LIFE_ENGINE_DISPLAY or LIFE_WARM_RESTART"
+#endif
+#endif
+
+#if DO_YOU_WANT_RUN_LOG && DO_YOU_WANT_STREAM
+#error "DO_YOU_WANT_RUN_LOG is for grids, a streaming board doesn't have any"
+#endif
+
+#if DO_YOU_WANT_TELEMETRY && !(DO_YOU_WANT_BUTTON && DO_YOU_WANT_SEVEN_SEGS)
+#error "DO_YOU_WANT_TELEMETRY needs the button and the 7 segment displays"
+#endif
+
+#if DO_YOU_WANT_SCHEDULER && DO_YOU_WANT_STREAM
+#error "DO_YOU_WANT_SCHEDULER is for the Game of Life's loop, streaming has its own"
+#endif
+#if DO_YOU_WANT_SCHEDULER && DO_YOU_WANT_TELEMETRY && !defined(TELE_TASK_US)
+#error "set DO_YOU_WANT_SCHEDULER from the Makefile, telemetry.h needs to see it too"
+#endif
+
+#if DO_YOU_WANT_LINK && !LINK_MASTER
+#define GENERATION_DUE() link_sync_seen() //slaves go when the master says
+#else
+#define GENERATION_DUE() gen_tick_flag
+#endif
+
+volatile uint8_t gen_tick_flag = 0; //set by timer1 when a generation is due
+#if DO_YOU_WANT_BUTTON
+uint8_t gen_ticks = GEN_TICKS; //current speed, in timer1 overflows
+uint8_t gen_paused = 0; //set to stop new generations being made
+
+//speeds a long press of the button goes through, in timer1 overflows
+const uint8_t gen_speeds[] PROGMEM = { GEN_TICKS, GEN_TICKS/2, GEN_TICKS/4, GEN_TICKS*2 };
+uint8_t gen_speed_index = 0;
+#else
+//only the button changes them, so without it they don't need RAM
+#define gen_ticks GEN_TICKS
+#define gen_paused 0
+#endif
 
 //framebuffer functions
 void clear_fb(void);
-void push_fb(void);
 
 //stuff for game of life things
 void get_new_states(void);
-uint8_t get_new_pixel_state(uint8_t in_states[], int8_t x, int8_t y);
-uint8_t get_current_pixel_state(uint8_t in[], int8_t x,int8_t y); 
-uint8_t get_difference(uint8_t a[],uint8_t b[]);
 
-//variables to store various difference counts
-uint8_t low_diff_count=0;
-uint8_t old_low_diff_count=0;
-uint16_t med_diff_count=0;
-uint16_t old_med_diff_count=0;
+#if LIFE_WARM_RESTART
+uint16_t generation_count LIFE_NOINIT;
+
+//checksum of generation_count and the grid's state, from warm_seal()
+#define WARM_SUM_START 0xc35a //so all zeros doesn't check out
+uint16_t warm_sum LIFE_NOINIT;
+
+uint16_t warm_state_sum(void);
+void warm_seal(void);
+uint8_t warm_start_ok(void);
+#else
+uint16_t generation_count=0;
+#endif
+
+#if DO_YOU_WANT_TELEMETRY
+uint8_t stack_high_water=0; //most stack used so far, see stack_check.h
+#endif
+
+#if DO_YOU_WANT_RUN_LOG
+//what the grid on the display was made from, for the run log
+uint16_t grid_seed LIFE_NOINIT;
+#endif
+
+//reset events. anything that wants a new "random" grid posts one of these
+//with post_reset_event(), which is safe to call from ISRs, and the reset
+//controller service_resets() acts on them between generations, so
+//reset_grid() only ever runs from the main loop.
+#define RESET_EV_STAGNANT (1<<0) //low/medium difference thresholds reached
+#define RESET_EV_BUTTON (1<<1) //the spectator pressed the button
+#define RESET_EV_GEN_OVERFLOW (1<<2) //generation count hit GEN_OVERFLOW_LIMIT
+#define RESET_EV_WATCHDOG (1<<3) //came up from a watchdog reset
+#define RESET_EV_POWER_ON (1<<4) //any other mcu reset (power on, RESET pin)
+#define RESET_EV_WALL (1<<5) //a wall slave, the master said so over the link
+
+volatile uint8_t reset_events=0; //pending events, see above
+uint8_t last_reset_reason=0; //events that caused the most recent reset
+
+void post_reset_event(uint8_t ev);
+void ask_reset(uint8_t ev);
+void service_resets(void);
+void init_reset_reason(void);
+
+#if DO_YOU_WANT_LINK && LINK_MASTER
+//resets the grid has asked for, for the whole wall. they go out to the
+//slaves with the next generation's sync pulse, see ask_reset()
+uint8_t wall_resets=0;
+#endif
 
-volatile uint16_t generation_count=0;
+void handle_button(void);
 
-//#define INIT_BUTTON BUTTON_DDR &= ~(1<<BUTTON_BIT);BUTTON_PORT |= (1<<BUTTON_BIT);
-void init_button(void);
+#if DO_YOU_WANT_TELEMETRY
+uint8_t tele_label=0; //generations left showing which readout it is
+void show_telemetry(void);
+#endif
 
-void init_srand(void);
+//where new "random" grids come from, a life_seed_next() state seeded
+//from the ADC, so it's the same generator the run log's seeds use and
+//rand() from avr-libc (and its 32 bit maths) isn't needed
+uint16_t grid_rand;
+void init_grid_rand(void);
+uint16_t new_seed(void);
 
 //void init_timer0(void);
 void init_timer1(void);
 
 void init_ADC(void);
 
-void set_ht1632_bright_ADC(uint8_t adc_num);
+void set_bright_ADC(uint8_t adc_num);
 
 void reset_grid(void);
 
+//the parts of the main loop
+#define MAIN_REFRESH (DO_YOU_WANT_SEVEN_SEGS || DISPLAY_NEEDS_REFRESH)
+void next_generation(void);
+void task_refresh(void);
+void task_prescreen(void);
+
+#if DO_YOU_WANT_SCHEDULER
+void task_generation(void);
+void task_button(void);
+void task_brightness(void);
+
+//the main loop's tasks, in the order they're run in, see sched.h.
+//with the periods in timer1 overflows (8.192ms)
+const struct sched_task tasks[] SCHED_FLASH = {
+    #if DO_YOU_WANT_BUTTON
+    { task_button, 1 }, //every overflow, like it was from the ISR
+    #endif
+    #if DO_YOU_WANT_LINK && !LINK_MASTER
+    { task_generation, 0 },
+    #else
+    { task_generation, GEN_TICKS }, //then gen_ticks, see task_generation()
+    #endif
+    #if MAIN_REFRESH
+    { task_refresh, 0 },
+    #endif
+    #if DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM
+    { task_brightness, GEN_TICKS }, //as often as it was at the first speed
+    #endif
+    #if LIFE_PRESCREEN
+    { task_prescreen, 0 },
+    #endif
+    #if DO_YOU_WANT_TELEMETRY
+    { tele_service, 0 },
+    #endif
+    #if DO_YOU_WANT_RUN_LOG
+    { runlog_service, 0 }, //a byte of the last record at a time
+    #endif
+};
+#define NB_TASKS (sizeof(tasks) / sizeof(tasks[0]))
+
+struct sched_slot task_slots[NB_TASKS];
+#endif
+
 //main code
 int main(void)
 {
+    #if LIFE_WARM_RESTART
+    uint8_t warm;
+    #endif
 //init stuff
     
-    //init the ht1632c LED matrix driver chip
-    ht1632c_init();
+    #if LIFE_WARM_RESTART
+    //the display doesn't get reset along with the mcu, so after a watchdog
+    //reset it is still showing the grid. if that and the rest of the
+    //grid's state check out, carry on from them without the cold start.
+    display_resume();
+    warm = warm_start_ok();
+    if(!warm)
+    #endif
+    //init the LED matrix (the ht1632c driver chip, or see display.h)
+    display_init();
     
     //init the ADC
     init_ADC();
     
-    //init srand() with a somewhat random number from ADC9's low bits
-    init_srand();
+    //start grid_rand from a somewhat random number from ADC9's low bits
+    init_grid_rand();
     
+    #if DO_YOU_WANT_BUTTON
     //init button stuff for input and pullup
-    //and setup INT0 for button if you set DO_YOU_WANT_BUTTON_INT0
     init_button();
+    #endif
     
     //init timer1 for use in triggering an interrupt
-    //on overflow, which updates the display and calculates new generation.
+    //on overflow, which samples the button and times the generations.
     init_timer1();
     
+    #if DO_YOU_WANT_SEVEN_SEGS
     //init the I/O for the 7 segment display control
     init_digit_pins();
     init_segment_pins();
+    #endif
+    
+    #if DO_YOU_WANT_TELEMETRY
+    //start timer0 for timing the timer1 ISR
+    init_telemetry();
+    #endif
+    
+    #if DO_YOU_WANT_LINK
+    //init the pins going to the boards either side
+    init_link();
+    #endif
+    
+    #if DO_YOU_WANT_STREAM
+    //init the USI for the frames coming in
+    init_stream();
+    #endif
     
-    //reset the display with a "random" array using rand()
-    reset_grid();
+    #if LIFE_WARM_RESTART
+    if(warm){
+        MCUSR = 0;
+        last_reset_reason = RESET_EV_WATCHDOG;
+        #if DO_YOU_WANT_RUN_LOG
+        //it still happened, even if it can't be seen
+        runlog_start(RESET_EV_WATCHDOG);
+        #endif
+        //the display may have been cut off part way through a push
+        life_all_changed();
+        #if DO_YOU_WANT_SEVEN_SEGS
+        count_set(generation_count);
+        #endif
+    } else {
+        //life_stag is in .noinit too, reset_grid() clears it
+        init_reset_reason();
+        service_resets();
+    }
+    #elif DO_YOU_WANT_STREAM
+    //start off blank, until the first keyframe comes
+    #else
+    //post why we are starting up, then let the reset controller
+    //fill the display with a "random" array using new_seed()
+    init_reset_reason();
+    service_resets();
+    #endif
+    
+    #if LIFE_ENGINE != LIFE_ENGINE_DISPLAY
+    //show it straight away rather than after the first generation's
+    //worth of timer1 overflows
+    display_push_all(fb);
+    #endif
     
     //test glider
     //fb[29] = 0b00100000;
     //fb[30] = 0b00101000;
     //fb[31] = 0b00110000;
     
-    //variable to store generation_count for display on 7 segment displays
-    uint16_t g_count=0;
+    #if LIFE_WARM_RESTART
+    warm_seal();
+    #endif
+    
+    #if DO_YOU_WANT_TO_USE_WATCHDOG==1
+    //setup watchdog
+    wdt_enable(WDTO_1S);
+    #endif
     
     //enable global interrupts
     sei();
     
+    #if DO_YOU_WANT_STREAM
+    //the frames are put in fb by the USI interrupt as they come,
+    //so all there is to do is send the columns that changed
+    while(1){
+        uint32_t changed;
+        
+        #if DO_YOU_WANT_TO_USE_WATCHDOG==1
+        wdt_reset();
+        #endif
+        
+        changed = stream_take_changed();
+        if(changed){
+            display_push(fb, changed);
+        }
+        
+        #if DISPLAY_NEEDS_REFRESH
+        display_refresh();
+        #endif
+        
+        #if DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM
+        //timer1 still ticks, the brightness gets read as often as the
+        //generations would have been made
+        if(gen_tick_flag){
+            gen_tick_flag=0;
+            set_bright_ADC(6);
+        }
+        #endif
+    }
+    #endif
+    
+    #if DO_YOU_WANT_SCHEDULER
+    //the same as the loop below, but each part is a task in tasks[]
+    sched_start(tasks, task_slots, NB_TASKS);
+    while(1){
+        #if DO_YOU_WANT_TO_USE_WATCHDOG==1
+        wdt_reset();
+        #endif
+        
+        sched_run(tasks, task_slots, NB_TASKS);
+    }
+    #endif
+    
     //infinite loop
     while(1){
         
-        //check if the update generation count flag has been set
-        //by within the timer1 overflow interrupt.
-        //if set put the updated value into g_count and reset the flag.
-        if(update_gen_flag){
-            g_count = generation_count;
-            update_gen_flag=0;
+        #if DO_YOU_WANT_TO_USE_WATCHDOG==1
+        //reset watchdog
+        wdt_reset();
+        #endif
+        
+        //check if the generation tick flag has been set
+        //by the timer1 overflow interrupt (or on a wall slave,
+        //if the master has started the next generation)
+        if(GENERATION_DUE()){
+            gen_tick_flag=0;
+            next_generation();
         }
-        write_number(g_count); //write the g_count to 7 segment displays
-        //write_number(generation_count);
         
-        //if the seven_seg_error flag is set (output is over 999 for 3 digits)
-        //then reset the grid 
-        if(seven_seg_error_flag){
-            reset_grid();
+        #if MAIN_REFRESH
+        task_refresh();
+        #endif
+        
+        #if LIFE_PRESCREEN
+        task_prescreen();
+        #endif
+        
+        #if DO_YOU_WANT_BUTTON
+        handle_button();
+        #endif
+        
+        #if DO_YOU_WANT_TELEMETRY
+        tele_service();
+        #endif
+        
+        #if DO_YOU_WANT_RUN_LOG
+        //a byte of the last record at a time, when the EEPROM is free
+        runlog_service();
+        #endif
+    }
+}
+
+void next_generation(void){
+//everything that's done once a generation, pushing the last one to the
+//display and making the next
+    //increment the generation count, and the BCD copy of it
+    //that the 7 segment displays show
+    generation_count++;
+    #if DO_YOU_WANT_SEVEN_SEGS
+    count_increment();
+    #endif
+    
+    #if DO_YOU_WANT_GEN_OVERFLOW_RESET
+    //if it has been going for long enough
+    //then ask for a reset at this generation
+    if(generation_count >= GEN_OVERFLOW_LIMIT){
+        ask_reset(RESET_EV_GEN_OVERFLOW);
+    }
+    #endif
+    //push framebuffer to the display, only the columns that changed.
+    //if none did there's nothing to push, and life_step() will
+    //return straight away too.
+    #if LIFE_ENGINE != LIFE_ENGINE_DISPLAY
+    if(life_changed){
+        display_push(fb, life_changed);
+    }
+    #endif
+    #if DO_YOU_WANT_LINK
+    //swap edge columns with the boards either side. a reset asked for
+    //last generation goes out with it, and every board in the wall does
+    //it at the end of this one, so the wall stays one grid
+    #if LINK_MASTER
+    link_exchange(wall_resets);
+    if(wall_resets){
+        post_reset_event(wall_resets);
+        wall_resets = 0;
+    }
+    #else
+    if(link_exchange(0) & LINK_RESET){
+        post_reset_event(RESET_EV_WALL);
+    }
+    #endif
+    #endif
+    //get the new states and add them to the framebuffer
+    get_new_states();
+    //this is the safe point between generations, so reseed
+    //here if anything asked for it
+    service_resets();
+    
+    #if DO_YOU_WANT_TELEMETRY
+    //after the reset so a new grid's readout isn't left as 000,
+    //before the stack check so its 'E' still shows
+    show_telemetry();
+    #endif
+    
+    #if DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM && !DO_YOU_WANT_SCHEDULER
+    //adc stuff to control pwm, a task of its own with the scheduler
+    set_bright_ADC(6);
+    #endif
+    
+    #if DO_YOU_WANT_STACK_CHECK && DO_YOU_WANT_SEVEN_SEGS
+    {
+        //the generation has just been made with the timer ISR able to
+        //come in on top of it, so this is about as deep as it gets
+        uint8_t used = stack_used();
+        #if DO_YOU_WANT_TELEMETRY
+        stack_high_water = used;
+        #endif
+        if((stack_size() - used) < STACK_MIN_FREE){
+            msg_error();
         }
     }
+    #endif
+    
+    #if LIFE_WARM_RESTART
+    //everything for this generation is done, so this is the
+    //state to come back to after a watchdog reset
+    warm_seal();
+    #endif
 }
 
+#if MAIN_REFRESH
+void task_refresh(void){
+//the displays that are multiplexed need going round all the time
+    #if DO_YOU_WANT_SEVEN_SEGS
+    refresh_digits(); //write the generation count to 7 segment displays
+    #endif
+    
+    #if DISPLAY_NEEDS_REFRESH
+    display_refresh(); //the LED matrix is multiplexed too
+    #endif
+}
+#endif
+
+#if LIFE_PRESCREEN
+void task_prescreen(void){
+//try out the next seed, one generation each time round so the
+//last digit doesn't stay lit for much longer than the others
+    if(life_prescreen() == LIFE_SEED_NEEDED){
+        life_prescreen_start(new_seed());
+    }
+}
+#endif
+
+#if DO_YOU_WANT_SCHEDULER
+void task_generation(void){
+//what GENERATION_DUE() is for in the plain loop
+    #if DO_YOU_WANT_LINK && !LINK_MASTER
+    //this is in every time round, the master says when
+    if(link_sync_seen()){
+        next_generation();
+    }
+    #else
+    //due every gen_ticks paused or not, like tick_count in the ISR of
+    //the plain loop, so the speed and unpausing act the same way
+    sched_delay(gen_ticks);
+    if(!gen_paused){
+        next_generation();
+    }
+    #endif
+}
+
+#if DO_YOU_WANT_BUTTON
+void task_button(void){
+//sample and debounce the button, and act on what it says
+    button_tick();
+    handle_button();
+}
+#endif
+
+#if DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM
+void task_brightness(void){
+//adc stuff to control pwm
+    set_bright_ADC(6);
+}
+#endif
+#endif
+
 void clear_fb(void){
 //clears the framebuffer
     uint8_t count;
@@ -144,44 +619,139 @@ void clear_fb(void){
     }
 }
 
-void push_fb(void){
-//pushes frambuffer into the ht1632c chip in the display
+#if LIFE_ENGINE == LIFE_ENGINE_DISPLAY
+//the ht1632c's RAM is the grid, column x is at address x*2 just like
+//display_push() uses, so new generations show up as soon as they're
+//worked out.
+uint8_t life_col_read(uint8_t x){
+    return ht1632c_read8(x*2);
+}
+
+void life_col_write(uint8_t x, uint8_t col){
+    ht1632c_data8((x*2),col);
+}
+#endif
+
+#if DO_YOU_WANT_BUTTON
+void handle_button(void){
+//acts on the debounced button events queued up by timer1
+    switch(button_get_event()){
+        case BUTTON_EV_SHORT:
+            //ask for a reset and "randomize" at the next generation
+            post_reset_event(RESET_EV_BUTTON);
+            break;
+        case BUTTON_EV_LONG:
+            #if DO_YOU_WANT_TELEMETRY
+            //go to the next readout, saying which it is first
+            msg_mode(tele_next_mode());
+            tele_label = 2;
+            #else
+            //go to the next speed
+            gen_speed_index++;
+            if(gen_speed_index >= sizeof(gen_speeds)){
+                gen_speed_index=0;
+            }
+            gen_ticks = pgm_read_byte(&gen_speeds[gen_speed_index]);
+            #endif
+            break;
+        case BUTTON_EV_DOUBLE:
+            //pause or resume
+            gen_paused ^= 1;
+            break;
+    }
+}
+#endif
+
+#if DO_YOU_WANT_TELEMETRY
+#ifdef TELE_TASK_US
+uint16_t task_worst(void){
+//the longest any task has taken
+    uint16_t worst=0;
+    uint8_t i;
     
-    uint8_t i=X_AXIS_LEN;
-    while(i--)
-    {
-        ht1632c_data8((i*2),fb[i]);
+    for(i=0; i<NB_TASKS; i++){
+        if(task_slots[i].worst > worst){
+            worst = task_slots[i].worst;
+        }
     }
+    return worst;
 }
+#endif
 
-void init_button(void){
-    //setup for input
-    BUTTON_DDR &= ~(1<<BUTTON_BIT);
-    //enable pullup
-    BUTTON_PORT |= (1<<BUTTON_BIT);
+void show_telemetry(void){
+//puts the readout picked with the button on the 7 segment displays,
+//once a generation
+    uint16_t value;
     
-    #if DO_YOU_WANT_BUTTON_INT0
-    //if you want the button to use INT0 for button on PB6
-        
-        //setup INT0 to trigger on falling edge
-        MCUCR |= (1<<ISC01);
-        //enable the INT0 external interrupt
-        GIMSK |= (1<<INT0);
-    #endif
+    if(tele_label){
+        if(--tele_label){
+            return; //still showing which readout it is
+        }
+        if(tele_mode == TELE_COUNT){
+            //it kept counting while hidden, count_increment() takes it
+            //from here
+            count_show();
+        }
+    }
+    switch(tele_mode){
+        case TELE_POPULATION:
+            value = life_population();
+            break;
+        case TELE_DIFF:
+            value = tele_diff;
+            break;
+        case TELE_ISR_US:
+            value = tele_isr_max;
+            break;
+        case TELE_RESET_REASON:
+            value = last_reset_reason;
+            break;
+        case TELE_RESETS_HOUR:
+            value = tele_resets_hour();
+            break;
+        case TELE_STACK:
+            #if DO_YOU_WANT_STACK_CHECK
+            value = stack_high_water;
+            #else
+            value = stack_used();
+            #endif
+            break;
+        #ifdef TELE_TASK_US
+        case TELE_TASK_US:
+            value = task_worst();
+            break;
+        #endif
+        default:
+            return; //TELE_COUNT
+    }
+    set_number(value);
 }
+#endif
 
-void init_srand(void){
+void init_grid_rand(void){
     
     ADMUX |= 9;//set to ADC9 input
     
     //start adc
     ADCSR |= (1<<ADSC);
     loop_until_bit_is_clear(ADCSR, ADSC);//wait until done
-    srand(ADCL); //for a pretty random adc reading
+    grid_rand = ADCL + 1; //for a pretty random adc reading, never 0
+    
+}
+
+uint16_t new_seed(void){
+//a seed for life_seed(). grid_rand moves on past all the states that
+//grid uses, so the next grid isn't this one shifted by a column
+    uint16_t seed = grid_rand;
+    uint8_t k;
     
+    for(k=0;k<X_AXIS_LEN;k++){
+        grid_rand = life_seed_next(grid_rand);
+    }
+    return seed;
 }
 
-void set_ht1632_bright_ADC(uint8_t adc_num){
+void set_bright_ADC(uint8_t adc_num){
     uint8_t temp_reg = ADMUX; //save current state
     
     ADMUX &= ~(0b11111); //clear bottom part
@@ -192,153 +762,137 @@ void set_ht1632_bright_ADC(uint8_t adc_num){
     
     loop_until_bit_is_clear(ADCSR, ADSC);//wait until done
     
-    ht1632c_bright(ADC/64);
+    display_bright(ADC/64);
     //generation_count=ADC/64;
     ADMUX = temp_reg; //reset ADMUX to original state
 }
 
 void reset_grid(void){
 //resets the framebuffer with "random" values
-    uint8_t k;
-    for(k=0;k<X_AXIS_LEN;k++){
-        fb[k] = ((uint8_t)rand() & 0xff);
+    uint16_t seed=0;
+    #if LIFE_PRESCREEN
+    //use the seed that has been tried out off screen if there is one,
+    //otherwise (like at power on) a random one has to do
+    seed = life_prescreen_take();
+    if(!seed)
+    #endif
+    {
+        //made from a seed, so the run log can say which grid it was
+        seed = new_seed();
+        life_seed(seed);
     }
+    #if DO_YOU_WANT_RUN_LOG
+    grid_seed = seed;
+    #endif
+    life_all_changed();
+    life_stagnant_clear();
+    #if LIFE_SHIP_CHECK
+    life_translated_reset();
+    #endif
     generation_count=0;
+    #if DO_YOU_WANT_SEVEN_SEGS
+    count_clear();
+    #endif
 }
 
-uint8_t get_current_pixel_state(uint8_t in[], int8_t x,int8_t y){
-//get the state (1==alive,0==dead), of a particular pixel/cell and return it
-
-    //for wrapping the display axis so the 
-    //Game of Life doesn't seem as restricted
-    //this is called a toroidal array
-    if(x < 0){ x = (X_AXIS_LEN - 1);}
-    if(x == X_AXIS_LEN) {x = 0;}
-    if(y < 0){ y = (Y_AXIS_LEN-1);}
-    if(y == Y_AXIS_LEN) {y = 0;}
-    
-    //return the value
-    return (in[x] & (1<<y));
+void post_reset_event(uint8_t ev){
+//flags a reset event, with interrupts held off so that an ISR posting
+//at the same time doesn't get lost
+    uint8_t sreg = SREG;
+    cli();
+    reset_events |= ev;
+    SREG = sreg;
 }
 
-uint8_t get_new_pixel_state(uint8_t in_states[], int8_t x,int8_t y){
-    
-    uint8_t n=0;//to store the neighbor count
-    uint8_t state_out=0;
-    
-    //check on neighbors, see how many are alive.
-    if(get_current_pixel_state(in_states, x-1,y)){n++;}
-    if(get_current_pixel_state(in_states, x-1,y+1)){n++;}
-    if(get_current_pixel_state(in_states, x-1,y-1)){n++;}
-    
-    if(get_current_pixel_state(in_states, x,y-1)){n++;}
-    if(get_current_pixel_state(in_states, x,y+1)){n++;}
-    
-    if(get_current_pixel_state(in_states, x+1,y)){n++;}
-    if(get_current_pixel_state(in_states, x+1,y+1)){n++;}
-    if(get_current_pixel_state(in_states, x+1,y-1)){n++;}
-    
-    //now determine if dead or alive by neighbors,
-    //these are implementing the rule's of Conway's Game of Life:
-    /* from Wikipedia
-     * Any live cell with fewer than two live neighbours dies, as if caused by under-population.
-     * Any live cell with two or three live neighbours lives on to the next generation.
-     * Any live cell with more than three live neighbours dies, as if by overcrowding.
-     * Any dead cell with exactly three live neighbours becomes a live cell, as if by reproduction.
-     */
-    if((n<2)){state_out=0;}
-    else if ((n<=3) && get_current_pixel_state(in_states, x, y)){state_out=1;}
-    else if ((n==3)){state_out=1;}
-    else if ((n>3)){state_out=0;}
-    
-    return state_out;
+void ask_reset(uint8_t ev){
+//for resets the grid asks for itself. on a wall the master decides for
+//all the boards, and only after it has told them (see next_generation()),
+//and what the slaves' own parts ask for doesn't count.
+    #if DO_YOU_WANT_LINK
+    #if LINK_MASTER
+    wall_resets |= ev;
+    #else
+    (void)ev;
+    #endif
+    #else
+    post_reset_event(ev);
+    #endif
 }
 
-void get_new_states(void){
-//find all the new states and put them in the buffer
-    
-    //copy the current stuff into storage
-    
-    int8_t x=X_AXIS_LEN;
-    while(x--){
-        int8_t y=Y_AXIS_LEN;
-        while(y--){
-            if(get_new_pixel_state(fb, x, y)==1){
-                state_storage[x] |= (1<<y);
-            } else {
-                state_storage[x] &= ~(1<<y);
-            }
-        }
-    }
-    //store the difference between the two generations in diff_val
-    //to be used in finding when to reset.
-    uint8_t diff_val= get_difference(state_storage,fb);
-    
-    if((diff_val <= 4)){
-        //if diff_val is a low difference then increment it's counter
-        low_diff_count++;
-    }
-    else if((diff_val<=8)){
-        //if diff_val is a medium difference then increment that counter
-        med_diff_count++;
-    }
-    else{
-        //if neither, then decrement their counters to stay longer before reset
-        if(low_diff_count > 0){
-            low_diff_count--;
-        }
-        if(med_diff_count >0){
-            med_diff_count--;
+void service_resets(void){
+//the reset controller, only to be called between generations.
+//it's called during init too, before main() turns interrupts on,
+//so it leaves them the way it found them like post_reset_event()
+    uint8_t sreg = SREG;
+    uint8_t ev;
+    
+    cli();
+    ev = reset_events;
+    reset_events = 0;
+    SREG = sreg;
+    
+    if(ev){
+        last_reset_reason = ev;
+        #if DO_YOU_WANT_RUN_LOG
+        if(ev & (RESET_EV_POWER_ON | RESET_EV_WATCHDOG)){
+            //just started up, there isn't a grid before this one
+            runlog_start(ev);
+        } else {
+            runlog_add(ev, generation_count, grid_seed);
         }
-    }
-    
-    #if DO_YOU_WANT_BUTTON_INT0==0
-    //if you don't want to use INT0 for button
-    //then this "if" statement will compile
-    //which just checks the button pin's state whenever
-    //this function runs
-    if(bit_is_clear(BUTTON_PIN, BUTTON_BIT)){
-        reset_grid();
-    } 
-    else 
-    #endif
-    if(low_diff_count > LOW_DIFF_THRESHOLD){
-    //if low_diff_count is above threshold, reset
-        low_diff_count=0;
-        reset_grid();
-    }
-    else if(med_diff_count > MED_DIFF_THRESHOLD){
-    //if med_diff_count is above threshold, reset
-        med_diff_count=0;
+        #endif
         reset_grid();
-    }
-    else{
-    //if it is interesting enough so far then just add the new generation
-    //to the framebuffer.
-        for(x=0;x<X_AXIS_LEN;x++){
-            //put the new values into the framebuffer
-            fb[x] = state_storage[x];
-        }
+        #if DO_YOU_WANT_TELEMETRY
+        tele_reset_seen();
+        #endif
     }
 }
 
-uint8_t get_difference(uint8_t a[],uint8_t b[])
-{//gets the amount of differences between two generations
-    uint8_t x_v,y_v,diff=0;
+#if LIFE_WARM_RESTART
+uint16_t warm_state_sum(void){
+    return life_state_sum(WARM_SUM_START ^ generation_count);
+}
 
-    for(x_v=0; x_v < X_AXIS_LEN; x_v++)
-    {
-        for(y_v=0; y_v < Y_AXIS_LEN; y_v++)
-        {
-            //if changed from 0 to 1 or vise-versa, then increment the difference value
-            if(( (get_current_pixel_state(a,x_v,y_v)==1) && (get_current_pixel_state(b,x_v,y_v) == 0)) 
-            || ((get_current_pixel_state(a,x_v,y_v)==0) && (get_current_pixel_state(b,x_v,y_v)==1)))
-            {
-                diff++;
-            }
-        }
+void warm_seal(void){
+    warm_sum = warm_state_sum();
+}
+
+uint8_t warm_start_ok(void){
+//1 if this is a watchdog reset, and the grid and generation_count are
+//the same as when they were last sealed
+    return (MCUSR & (1<<WDRF)) && (warm_sum == warm_state_sum());
+}
+#endif
+
+void init_reset_reason(void){
+//posts the reason the mcu (re)started as the first reset event
+    if(MCUSR & (1<<WDRF)){
+        post_reset_event(RESET_EV_WATCHDOG);
+    } else {
+        post_reset_event(RESET_EV_POWER_ON);
+    }
+    MCUSR = 0;
+}
+
+void get_new_states(void){
+//find all the new states and put them in the framebuffer
+    
+    //store the difference between the two generations in diff_val
+    //to be used in finding when to reset. if a reset is posted the new
+    //generation gets replaced by service_resets() right after this.
+    uint8_t diff_val= life_step();
+    #if DO_YOU_WANT_TELEMETRY
+    tele_diff = diff_val;
+    #endif
+    if(life_stagnant(diff_val)){
+        ask_reset(RESET_EV_STAGNANT);
     }
-    return diff;
+    #if LIFE_SHIP_CHECK
+    //the whole grid is just sliding round, like a lone glider
+    if(life_translated()){
+        ask_reset(RESET_EV_STAGNANT);
+    }
+    #endif
 }
 
 /*
@@ -352,11 +906,12 @@ void init_timer0(void){
 
 void init_timer1(void){
 
-    //set prescaler to CK/16384
+    //set prescaler to CK/256
     //with 8MHz clock, and 8bit timer/counter1
-    //this prescaler should make it overflow every 0.52224 seconds
-    //a good generation update rate for the Game of Life.
-    TCCR1B |= ((1<<CS13)|(1<<CS12)|(1<<CS11)|(1<<CS10));
+    //this prescaler should make it overflow every 8.192ms, fast enough
+    //to debounce the button. GEN_TICKS of these make one generation,
+    //64 gives the old 0.52224 seconds, a good update rate for the Game of Life.
+    TCCR1B |= ((1<<CS13)|(1<<CS10));
     //enable timer1 overflow interrupt
     TIMSK |= (1<<TOIE1);
 }
@@ -364,8 +919,10 @@ void init_timer1(void){
 void init_ADC(void){
     //init the ADC
     
+    #if DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM
     DDRA &= ~(1<<7);//make sure it is set to input on PA7
     PORTA &= ~(1<<7);//make sure there are no pullups 
+    #endif
     //set clock prescaler to div 16
     ADCSR |= (1<<ADPS2);
     
@@ -378,41 +935,42 @@ void init_ADC(void){
 
 ISR(TIMER1_OVF1_vect){
     //timer1 overflow interrupt service routine
+    #if !DO_YOU_WANT_SCHEDULER
+    static uint8_t tick_count=0;
+    #endif
+        #if DO_YOU_WANT_TELEMETRY
+        uint8_t isr_start = TCNT0; //timer0 counts in us
+        #endif
         
-        //increment the generation count
-        generation_count++;
-        //push framebuffer to the display
-        push_fb();
-        //get the new states and add them to the framebuffer,
-        //or reset the display if there isn't enough action
-        get_new_states();
-        
-        //set the update_gen_flag that will alert the "if" statement
-        //in the main while(1) loop, so it will update the 7 segment display
-        //with the new generation count
-        update_gen_flag=1;
-        
-        
-        #if DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM
-        //if you set the DO_YOU_WANT_ADC6_INPUT_TO_HT1632C_PWM to "1"
-        //then this below code will compile
+        #if DO_YOU_WANT_SCHEDULER
+        //the tasks do everything else when they see it's gone up
+        sched_ticks++;
+        #else
+        #if DO_YOU_WANT_BUTTON
+        //sample and debounce the button
+        button_tick();
+        #endif
         
-        //adc stuff to control pwm
-        set_ht1632_bright_ADC(6);
+        //every gen_ticks overflows set the gen_tick_flag that will alert
+        //the "if" statement in the main while(1) loop, which pushes the
+        //framebuffer, calculates the next generation and updates the
+        //7 segment display
+        if(++tick_count >= gen_ticks){
+            tick_count=0;
+            if(!gen_paused){
+                gen_tick_flag=1;
+            }
+        }
+        #endif
         
-        #endif //end of this little snippet
+        #if DO_YOU_WANT_TELEMETRY
+        tele_isr_done(isr_start);
+        #endif
 }
 
-
-#if DO_YOU_WANT_BUTTON_INT0
-//if you want a button to use INT0 for button on PB6
-
-ISR(INT0_vect){
-//INT0 ISR, activated by falling edge
-//made when button pressed
-
-    //reset and "randomize"
-    reset_grid();
+#if DO_YOU_WANT_STREAM
+ISR(USI_OVF_vect){
+    //a byte of a frame has come in, see stream_avr.c
+    stream_usi_byte();
 }
-
 #endif
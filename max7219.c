@@ -0,0 +1,74 @@
+//driver for a chain of MAX7219s, see max7219.h
+
+#include "max7219.h"
+
+#include <avr/io.h>
+
+//the same pins as the ht1632c
+#define MAX7219_PORT PORTB
+#define MAX7219_DDR DDRB
+#define MAX7219_LOAD _BV(3)
+#define MAX7219_CLK _BV(4)
+#define MAX7219_DIN _BV(5)
+
+static void max7219_byte(uint8_t byte){
+//shifts out a byte MSB first, DIN is read on the rising edge of CLK
+    uint8_t mask = 0x80;
+    while(mask){
+        MAX7219_PORT &= ~MAX7219_CLK;
+        if(byte & mask){
+            MAX7219_PORT |= MAX7219_DIN;
+        } else {
+            MAX7219_PORT &= ~MAX7219_DIN;
+        }
+        MAX7219_PORT |= MAX7219_CLK;
+        mask >>= 1;
+    }
+}
+
+void max7219_init_pins(void){
+    uint8_t mask = MAX7219_LOAD | MAX7219_CLK | MAX7219_DIN;
+    
+    MAX7219_PORT |= MAX7219_LOAD;
+    MAX7219_PORT &= ~(MAX7219_CLK | MAX7219_DIN);
+    MAX7219_DDR |= mask;
+}
+
+void max7219_init(void){
+    uint8_t d;
+    
+    max7219_init_pins();
+    
+    //they come up shut down, with junk in the digit registers
+    max7219_all(MAX7219_TEST, 0);
+    max7219_all(MAX7219_DECODE, 0); //no BCD, the bits are the LEDs
+    max7219_all(MAX7219_SCAN_LIMIT, 7); //all 8 digits
+    max7219_all(MAX7219_INTENSITY, 7);
+    for(d=0; d<8; d++){
+        max7219_all(MAX7219_DIGIT0 + d, 0);
+    }
+    max7219_all(MAX7219_SHUTDOWN, 1); //turn on
+}
+
+void max7219_all(uint8_t reg, uint8_t val){
+    uint8_t m;
+    
+    MAX7219_PORT &= ~MAX7219_LOAD;
+    for(m=0; m<MAX7219_CHAIN; m++){
+        max7219_byte(reg);
+        max7219_byte(val);
+    }
+    MAX7219_PORT |= MAX7219_LOAD; //every module latches on the rising edge
+}
+
+void max7219_digit(uint8_t dig, const uint8_t *cols){
+    uint8_t m = MAX7219_CHAIN;
+    
+    MAX7219_PORT &= ~MAX7219_LOAD;
+    //the first 16 bits out end up in the module furthest away
+    while(m--){
+        max7219_byte(MAX7219_DIGIT0 + dig);
+        max7219_byte(cols[m*8]);
+    }
+    MAX7219_PORT |= MAX7219_LOAD;
+}
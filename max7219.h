@@ -0,0 +1,36 @@
+//driver for a chain of MAX7219 LED drivers, each with an 8x8 matrix, bit
+//banged on the ht1632c's pins: CS for LOAD, WR for CLK and DATA for DIN.
+//each module's digit registers 1-8 have to be its columns, left to right,
+//with bit 0 the top row, so mount the modules the right way round for that.
+
+
+//header file with the MAX7219 stuff
+
+#ifndef MAX7219_H
+#define MAX7219_H
+
+#include <stdint.h>
+
+#define MAX7219_CHAIN 4 //modules, the one nearest the mcu shows columns 0-7
+
+//registers
+#define MAX7219_NOOP 0x00
+#define MAX7219_DIGIT0 0x01 //digits 0-7 are registers 1-8
+#define MAX7219_DECODE 0x09
+#define MAX7219_INTENSITY 0x0a
+#define MAX7219_SCAN_LIMIT 0x0b
+#define MAX7219_SHUTDOWN 0x0c
+#define MAX7219_TEST 0x0f
+
+void max7219_init_pins(void);
+
+//sets up every module and clears it before turning it on
+void max7219_init(void);
+
+//writes val to register reg of every module, in one load
+void max7219_all(uint8_t reg, uint8_t val);
+
+//writes digit dig of every module in one load, module m gets cols[m*8]
+void max7219_digit(uint8_t dig, const uint8_t *cols);
+
+#endif
@@ -0,0 +1,87 @@
+//run log, the part that doesn't care where it's kept, see runlog.h
+
+//the functions
+
+#include "runlog.h"
+
+static uint8_t rec[RUNLOG_REC]; //record being written
+static uint8_t rec_left=0; //bytes of it still to write
+static uint8_t next_seq=0;
+static uint8_t boots=0;
+
+#define SLOT_ADDR(slot) ((uint8_t)((slot) * RUNLOG_REC))
+
+uint8_t runlog_valid(uint8_t slot){
+    uint8_t i, sum=0;
+    
+    for(i=0; i<RUNLOG_REC; i++){
+        sum += runlog_read(SLOT_ADDR(slot) + i);
+    }
+    return (sum == RUNLOG_SUM);
+}
+
+uint8_t runlog_newest(void){
+    uint8_t slot, next;
+    
+    for(slot=0; slot<RUNLOG_SLOTS; slot++){
+        if(!runlog_valid(slot)){
+            continue;
+        }
+        next = (slot + 1) % RUNLOG_SLOTS;
+        if(!runlog_valid(next)
+        || (runlog_read(SLOT_ADDR(next) + RL_SEQ)
+            != (uint8_t)(runlog_read(SLOT_ADDR(slot) + RL_SEQ) + 1))){
+            return slot;
+        }
+    }
+    return RUNLOG_SLOTS;
+}
+
+void runlog_add(uint8_t reason, uint16_t gens, uint16_t seed){
+    uint8_t i, sum=0;
+    
+    if(rec_left){
+        //the last one is still being written. waiting for it could hold
+        //everything up for RUNLOG_REC EEPROM writes, so it's merged into
+        //this one instead, which goes in its slot from the start again
+        reason |= rec[RL_REASON];
+        gens += rec[RL_GENS] | ((uint16_t)rec[RL_GENS+1] << 8);
+    } else {
+        rec[RL_SEQ] = next_seq++;
+    }
+    rec[RL_BOOT] = boots;
+    rec[RL_REASON] = reason;
+    rec[RL_GENS] = (uint8_t)gens;
+    rec[RL_GENS+1] = (uint8_t)(gens >> 8);
+    rec[RL_SEED] = (uint8_t)seed;
+    rec[RL_SEED+1] = (uint8_t)(seed >> 8);
+    for(i=0; i<RL_CHECK; i++){
+        sum += rec[i];
+    }
+    rec[RL_CHECK] = RUNLOG_SUM - sum;
+    rec_left = RUNLOG_REC;
+}
+
+void runlog_start(uint8_t reason){
+    uint8_t newest = runlog_newest();
+    
+    rec_left = 0; //anything that was being written went with the power
+    next_seq = 0;
+    boots = 0;
+    if(newest < RUNLOG_SLOTS){
+        next_seq = runlog_read(SLOT_ADDR(newest) + RL_SEQ) + 1;
+        boots = runlog_read(SLOT_ADDR(newest) + RL_BOOT) + 1;
+    }
+    runlog_add(reason, 0, 0);
+}
+
+void runlog_service(void){
+//the record goes in slot rec[RL_SEQ], in order, the check byte last
+    uint8_t i;
+    
+    if(rec_left && runlog_ready()){
+        i = RUNLOG_REC - rec_left;
+        runlog_write(SLOT_ADDR(rec[RL_SEQ] % RUNLOG_SLOTS) + i, rec[i]);
+        rec_left--;
+    }
+}
@@ -0,0 +1,77 @@
+//run log: a record of every grid in the EEPROM, so how long they lasted
+//and why they were reset is still there after the power goes. it's for
+//tuning LOW_DIFF_THRESHOLD and friends from boards that have been running
+//for weeks, read the EEPROM out with something like
+//`avrdude ... -U eeprom:r:eeprom.bin:r` and look at it with
+//host/runlog_dump.c.
+//
+//the ATtiny26's 128 bytes of EEPROM are a ring of RUNLOG_SLOTS records,
+//each RUNLOG_REC bytes:
+//
+//  RL_SEQ     goes up by one each record, and record seq is always in
+//             slot seq % RUNLOG_SLOTS, so the newest one is the one the
+//             next slot doesn't carry on from
+//  RL_BOOT    how many times the board had started up, as of this record
+//  RL_REASON  the RESET_EV_... bits (see main.c) that ended the grid.
+//             RESET_EV_POWER_ON or RESET_EV_WATCHDOG on their own mean the
+//             board has just started up, with no grid before it.
+//             a record for grids that ended too close together to be
+//             written one after the other has all their bits, and their
+//             generations added up in RL_GENS (see runlog_add())
+//  RL_GENS    generations the grid lasted, 2 bytes, low byte first
+//  RL_SEED    life_seed() seed the grid was made from, 2 bytes, low first
+//  RL_CHECK   makes the record's bytes add up to RUNLOG_SUM, so a record
+//             cut off by the power going (or never written, 0xff) doesn't
+//             count
+//
+//going round the ring spreads the writes over all of the EEPROM, and
+//bytes that are the same as last time round aren't written at all.
+
+
+//header file with run log stuff
+
+#ifndef RUNLOG_H
+#define RUNLOG_H
+
+#include <stdint.h>
+
+#define RUNLOG_SIZE 128
+#define RUNLOG_REC 8
+#define RUNLOG_SLOTS (RUNLOG_SIZE / RUNLOG_REC)
+
+#define RL_SEQ 0
+#define RL_BOOT 1
+#define RL_REASON 2
+#define RL_GENS 3
+#define RL_SEED 5
+#define RL_CHECK 7
+
+#define RUNLOG_SUM 0x5a
+
+//these have to be provided by whatever the log is kept in, runlog_avr.c
+//on the board
+uint8_t runlog_read(uint8_t addr);
+uint8_t runlog_ready(void); //1 if runlog_write() won't have to wait
+void runlog_write(uint8_t addr, uint8_t b);
+
+//1 if the record in slot is all there
+uint8_t runlog_valid(uint8_t slot);
+
+//the slot with the newest record in it, or RUNLOG_SLOTS if there aren't any
+uint8_t runlog_newest(void);
+
+//finds where the log is up to, and logs that the board has started up,
+//with reason RESET_EV_POWER_ON or RESET_EV_WATCHDOG
+void runlog_start(uint8_t reason);
+
+//logs a grid that has just ended. the record is written a byte at a time
+//by runlog_service(), so it doesn't hold anything up. if the last one
+//isn't finished yet it doesn't wait for it, the two are merged into one
+//record: both reasons, the generations added up and the newer seed.
+void runlog_add(uint8_t reason, uint16_t gens, uint16_t seed);
+
+//writes the next byte if there's one waiting and the EEPROM is free, call
+//this from the main loop
+void runlog_service(void);
+
+#endif
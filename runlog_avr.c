@@ -0,0 +1,21 @@
+//run log
+
+//the EEPROM side of it, see runlog.h
+
+#include "runlog.h"
+
+#include <avr/eeprom.h>
+
+uint8_t runlog_read(uint8_t addr){
+    return eeprom_read_byte((const uint8_t *)(uintptr_t)addr);
+}
+
+uint8_t runlog_ready(void){
+    return eeprom_is_ready();
+}
+
+void runlog_write(uint8_t addr, uint8_t b){
+    //a write takes about 8.5ms, and only the byte that's being changed
+    //gets worn, so leave it alone if it's the same already
+    eeprom_update_byte((uint8_t *)(uintptr_t)addr, b);
+}
@@ -0,0 +1,65 @@
+//cooperative task scheduler, the part that doesn't care where the ticks
+//come from, see sched.h
+
+//the functions
+
+#include "sched.h"
+
+#ifdef __AVR__
+#define TASK_RUN(t) ((void (*)(void))(uintptr_t)pgm_read_word(&(t)->run))
+#define TASK_PERIOD(t) pgm_read_byte(&(t)->period)
+#else
+#define TASK_RUN(t) ((t)->run)
+#define TASK_PERIOD(t) ((t)->period)
+#endif
+
+volatile uint8_t sched_ticks=0;
+
+static uint8_t delay_ticks; //what sched_delay() asked for, 0 if nothing
+
+void sched_start(const struct sched_task *tasks, struct sched_slot *slots,
+                 uint8_t n){
+    uint8_t i;
+
+    for(i=0; i<n; i++){
+        slots[i].due = sched_ticks + TASK_PERIOD(&tasks[i]);
+        slots[i].runs = 0;
+        slots[i].worst = 0;
+    }
+}
+
+void sched_run(const struct sched_task *tasks, struct sched_slot *slots,
+               uint8_t n){
+    uint8_t i, period, due;
+    uint16_t start, took;
+
+    for(i=0; i<n; i++){
+        struct sched_slot *s = &slots[i];
+
+        period = TASK_PERIOD(&tasks[i]);
+        due = s->due; //when it was due this time, for sched_delay()
+        if(period){
+            if((int8_t)(sched_ticks - due) < 0){
+                continue; //not yet
+            }
+            s->due = due + period;
+        }
+        delay_ticks = 0;
+
+        start = sched_time();
+        TASK_RUN(&tasks[i])();
+        took = sched_time() - start; //right even if it wrapped once
+
+        if(delay_ticks){
+            s->due = due + delay_ticks;
+        }
+        s->runs++;
+        if(took > s->worst){
+            s->worst = took;
+        }
+    }
+}
+
+void sched_delay(uint8_t ticks){
+    delay_ticks = ticks;
+}
@@ -0,0 +1,67 @@
+//cooperative task scheduler for the main loop: a fixed table of tasks,
+//each run to completion when it's due, with how many times each has been
+//run and the longest it has taken kept for every slot. the timer1 ISR only counts ticks for it, everything
+//else happens in the tasks.
+//
+//tasks don't get interrupted by each other, so the longest any task has
+//to wait for is everything else in the table taking its worst case at
+//once, and the worst cases are all there to see. a task that has a lot
+//to do should do a bit of it each time (like runlog_service() and
+//life_prescreen() do) rather than hold everything else up.
+
+
+//header file with scheduler stuff
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+//the tables live in flash on the AVR
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define SCHED_FLASH PROGMEM
+#else
+#define SCHED_FLASH
+#endif
+
+#define SCHED_TIME_US 32 //sched_time() steps, timer1 at CK/256 and 8MHz
+
+//a slot in the task table
+struct sched_task {
+    void (*run)(void);
+    uint8_t period; //ticks from one run to the next, up to 128, or 0 to
+                    //run every time round the loop
+};
+
+//what's kept about each slot
+struct sched_slot {
+    uint8_t due; //tick it's next due at
+    uint16_t runs; //times it has been run, wrapping
+    uint16_t worst; //longest it has taken, in SCHED_TIME_US
+};
+
+//timer ticks, the ISR adds one to it (timer1 overflows, 8.192ms)
+extern volatile uint8_t sched_ticks;
+
+//makes each task with a period first due that long from now, like the
+//counting in the plain loop, with no runs or worst case yet
+void sched_start(const struct sched_task *tasks, struct sched_slot *slots,
+                 uint8_t n);
+
+//one time round the loop: runs each task in the table that's due, in
+//order. one that has got behind is run once each time round until it has
+//caught up, so it still gets run once per period, just late.
+void sched_run(const struct sched_task *tasks, struct sched_slot *slots,
+               uint8_t n);
+
+//for a task with a period, called while it runs: it's next due ticks
+//(1 to 128) after it was due this time, instead of its period
+void sched_delay(uint8_t ticks);
+
+//has to be provided by whatever the ticks come from, sched_avr.c on the
+//board. a free running count in SCHED_TIME_US steps, wrapping, that
+//sched_ticks is the high byte of.
+uint16_t sched_time(void);
+
+#endif
@@ -0,0 +1,26 @@
+//cooperative task scheduler
+
+//the timer side of it, see sched.h
+
+#include "sched.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+uint16_t sched_time(void){
+    uint8_t sreg = SREG;
+    uint8_t ticks, count;
+
+    //TCNT1 counts 32us steps (CK/256) up to the overflow that sched_ticks
+    //counts. if it has overflowed since the ISR last ran, sched_ticks
+    //hasn't caught up yet.
+    cli();
+    count = TCNT1;
+    ticks = sched_ticks;
+    if((TIFR & (1<<TOV1)) && !(count & 0x80)){
+        ticks++;
+    }
+    SREG = sreg;
+
+    return ((uint16_t)ticks << 8) | count;
+}
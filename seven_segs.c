@@ -14,6 +14,14 @@ uint8_t digit_bits[] PROGMEM = { DIG_0, DIG_1, DIG_2 };
 const uint8_t num_digits = 3;
 uint8_t seven_seg_error_flag=0;
 
+uint8_t seg_buf[3];
+static uint8_t count_digits[3]; //BCD counter, digit 0 is the ones
+uint8_t count_hidden=0;
+
+static uint8_t digit_segs(uint8_t num);
+static void error_segs(void);
+static void count_draw(void);
+
 //const 
 uint8_t number_seg_bytes[]  PROGMEM = {
 //       unconfigured
@@ -28,9 +36,16 @@ uint8_t number_seg_bytes[]  PROGMEM = {
 0b11100001,//7
 0b11111111,//8
 0b11100111,//9
-0b10011111, //'E' for error
+0b11101111,//A
+0b00111111,//b
+0b10011100,//C
+0b01111011,//d
+0b10011111,//E, also for error
+0b10001111,//F
 };
 
+#define SEGS_ERROR 14 //index of 'E' above
+
 void init_digit_pins(void){
     
     //setup bits 0-2 in DDRB for output for digits 0-2
@@ -44,67 +59,160 @@ void init_segment_pins(void){
 }
 
 
-void write_digit(int8_t num, uint8_t dig){
-    uint8_t k;
-    uint8_t out_byte;
-    
-    if((num < 10) && (num >= 0)){
-    //out_byte = number_seg_bytes[num];
-    out_byte = pgm_read_byte(&number_seg_bytes[num]);
-    } else {
-    
-    //out_byte = number_seg_bytes[10];
-    out_byte = pgm_read_byte(&number_seg_bytes[10]);
+static uint8_t digit_segs(uint8_t num){
+//looks up the segments for num, shifted right 1 bit to correctly
+//use the values from number_seg_bytes.
+    if(num > 15){
+        num = SEGS_ERROR;
     }
+    return (pgm_read_byte(&number_seg_bytes[num])>>1);
+}
+
+void write_digit(uint8_t dig){
+//outputs the segments in seg_buf[dig] on digit dig
     
-    //output the byte to the port, shift right 1 bit to correctly
-    //use the values from number_seg_bytes.
-    write_segs((out_byte>>1));
-    //SEGMENT_PORT = (out_byte>>1);
+    //turn the digits off while the segments change, so there's no ghosting
+    DIGIT_PORT &= ~ALL_DIGS;
+    write_segs(seg_buf[dig]);
+    DIGIT_PORT |= pgm_read_byte(&digit_bits[dig]);
     
-    for( k = 0; k < num_digits; k++){
-        if ( k == dig ){
-                //PORTB |= pgm_read_byte(&digit_bits[k]);
-                DIGIT_PORT |= pgm_read_byte(&digit_bits[k]);
-        } else {
-                //PORTB &= ~(pgm_read_byte(&digit_bits[k]));
-                DIGIT_PORT &= ~(pgm_read_byte(&digit_bits[k]));
-        }
-    }
     _delay_ms(DIGIT_DELAY_MS);
-    
+}
+
+void refresh_digits(void){
+    uint8_t h;
+    for(h=0;h < num_digits;h++){
+        write_digit(h);
+    }
+}
+
+static void error_segs(void){
+    seg_buf[0] = digit_segs(SEGS_ERROR);
+    seg_buf[1] = 0;
+    seg_buf[2] = 0;
 }
 
 void msg_error(void){
-    write_digit(10, 0);
     seven_seg_error_flag=1;
+    if(!count_hidden){
+        error_segs();
+    }
 }
 
-void write_number(int16_t number){
-        uint8_t h;
-        int16_t format_num = number;
-        //check if number is too big ot not
-        if ((number < 1000) && (number >= 0)){
-            //formats number based on digits to correct digits on display
-            for(h=0;h < num_digits;h++){
-                write_digit(format_num % 10, h);
-                format_num /= 10;
-            }         
-        } else {
+void msg_mode(uint8_t num){
+    count_hidden=1;
+    seg_buf[0] = SEG_G;
+    seg_buf[1] = digit_segs(num);
+    seg_buf[2] = SEG_G;
+}
+
+static void count_draw(void){
+//puts the whole counter into seg_buf
+    uint8_t h;
+    if(seven_seg_error_flag){
+        error_segs();
+        return;
+    }
+    for(h=0;h < num_digits;h++){
+        seg_buf[h] = digit_segs(count_digits[h]);
+    }
+}
+
+void count_show(void){
+    count_hidden=0;
+    count_draw();
+}
+
+void count_clear(void){
+    uint8_t h;
+    seven_seg_error_flag=0;
+    for(h=0;h < num_digits;h++){
+        count_digits[h] = 0;
+    }
+    if(!count_hidden){
+        count_draw();
+    }
+}
+
+void count_increment(void){
+    uint8_t h;
+    uint8_t base = (GEN_COUNT_MODE == COUNT_MODE_HEX) ? 16 : 10;
+    if(seven_seg_error_flag){
+        return; //keep showing 'E' until count_clear()
+    }
+    for(h=0;h < num_digits;h++){
+        if(++count_digits[h] >= base){
+            //carry into the next digit
+            count_digits[h] = 0;
+        }
+        if(!count_hidden){
+            seg_buf[h] = digit_segs(count_digits[h]);
+        }
+        if(count_digits[h]){
+            return;
+        }
+    }
+    //carried out of the last digit, too big for 3 digits.
+    //the other modes just keep going from the rolled over digits
+    if(GEN_COUNT_MODE == COUNT_MODE_ERROR){
+        msg_error();
+    }
+}
+
+void count_set(uint16_t number){
+    uint8_t h;
+    uint8_t base = (GEN_COUNT_MODE == COUNT_MODE_HEX) ? 16 : 10;
+    uint16_t place[3];
+    
+    place[0] = 1;
+    place[1] = base;
+    place[2] = base * base;
+    
+    count_clear();
+    //what count_increment() does when it carries out of the last digit
+    while(number >= place[2] * base){
+        if(GEN_COUNT_MODE == COUNT_MODE_ERROR){
             msg_error();
+            return;
+        }
+        number -= place[2] * base;
+    }
+    for(h=num_digits;h--;){
+        while(number >= place[h]){
+            number -= place[h];
+            count_digits[h]++;
         }
+    }
+    if(!count_hidden){
+        count_draw();
+    }
 }
 
-//this is so we avoid writing to PORTA bit 7, which is connected to the
-//ADC for brightness control.
-void write_segs(uint8_t byte){
-    uint8_t o=7;
-    while(o--){
-        if(byte & (1<<o)){
-            SEGMENT_PORT |= (1<<o);
+void set_number(int16_t number){
+    uint8_t hundreds=0, tens=0;
+    
+    count_hidden=1;
+    //check if number is too big ot not
+    if ((number < 1000) && (number >= 0)){
+        while(number >= 100){
+            number -= 100;
+            hundreds++;
         }
-        else{
-            SEGMENT_PORT &= ~(1<<o);
+        while(number >= 10){
+            number -= 10;
+            tens++;
         }
+        seg_buf[0] = digit_segs(number);
+        seg_buf[1] = digit_segs(tens);
+        seg_buf[2] = digit_segs(hundreds);
+    } else {
+        //just 'E', it's not the counter that has gone wrong
+        error_segs();
     }
 }
+
+//this is so we avoid writing to PORTA bit 7, which is connected to the
+//ADC for brightness control.
+void write_segs(uint8_t byte){
+    SEGMENT_PORT = (SEGMENT_PORT & ~ALL_SEGS) | (byte & ALL_SEGS);
+}
@@ -75,13 +75,57 @@ extern const uint8_t  num_digits;
 
 extern uint8_t seven_seg_error_flag;
 
+//ways of showing the counter once it doesn't fit in 3 decimal digits,
+//none of them stop it counting.
+#define COUNT_MODE_ERROR 0 //decimal, 'E' and seven_seg_error_flag past 999
+#define COUNT_MODE_ROLL 1 //decimal, keeps showing the last 3 digits past 999
+#define COUNT_MODE_HEX 2 //hexadecimal, up to 0xFFF then the last 3 digits
+
+//the one the counter uses. it's fixed when it's built, so it takes no RAM
+#ifndef GEN_COUNT_MODE
+#define GEN_COUNT_MODE COUNT_MODE_ROLL
+#endif
+
+//set while something other than the counter is in seg_buf, msg_mode()
+//and set_number() set it. the counter carries on counting underneath,
+//it just doesn't touch seg_buf until count_show() puts it back.
+extern uint8_t count_hidden;
+
+//segment patterns for each digit, ready for write_segs(), digit 0 is the
+//ones. refresh_digits() only ever outputs these, anything that changes the
+//number shown converts it into here once.
+extern uint8_t seg_buf[];
+
 void init_digit_pins(void);
 void init_segment_pins(void);
 
 void msg_error(void);
 
-void write_number(int16_t number);
-void write_digit(int8_t num, uint8_t dig);
+//shows -n-, for saying which of several things is being shown.
+//hides the counter, see count_hidden
+void msg_mode(uint8_t num);
+
+//multiplexes seg_buf onto the displays, call this continuously
+void refresh_digits(void);
+
+//the counter kept as BCD (or hex) digits, so showing it never needs a
+//division. in COUNT_MODE_ERROR count_increment() sets
+//seven_seg_error_flag when it goes past 999.
+void count_clear(void);
+void count_increment(void);
+
+//puts the counter back on the displays after something else was shown
+void count_show(void);
+
+//sets the counter to number, as if count_increment() had been called
+//that many times since count_clear(), also by subtraction
+void count_set(uint16_t number);
+
+//show any other number, converts by subtraction rather than division.
+//hides the counter, see count_hidden
+void set_number(int16_t number);
+
+void write_digit(uint8_t dig);
 
 void write_segs(uint8_t byte);
 
@@ -0,0 +1,37 @@
+//stack high water mark, for keeping an eye on the 128 bytes of SRAM
+
+//the functions
+
+#include "stack_check.h"
+
+#include <avr/io.h>
+
+//from the linker script, the end of .bss/.noinit and the top of RAM
+extern uint8_t _end;
+extern uint8_t __stack;
+
+void stack_paint(void) __attribute__ ((naked, used, section (".init3")));
+
+//runs from .init3, after the stack pointer and r1 are set up but
+//before anything has been put on the stack, so it can fill it all.
+//it's naked and never called, so it can't use any stack itself.
+void stack_paint(void){
+    uint8_t *p = &_end;
+    while(p <= &__stack){
+        *p++ = STACK_PAINT;
+    }
+}
+
+uint8_t stack_used(void){
+    const uint8_t *p = &_end;
+    //the stack grows down from __stack, so skip over the bytes at the
+    //bottom that it has never reached
+    while((p <= &__stack) && (*p == STACK_PAINT)){
+        p++;
+    }
+    return (uint8_t)(&__stack - p + 1);
+}
+
+uint8_t stack_size(void){
+    return (uint8_t)(&__stack - &_end + 1);
+}
@@ -0,0 +1,24 @@
+//stack high water mark, for keeping an eye on the 128 bytes of SRAM
+
+
+//header file with stack checking stuff
+
+#ifndef STACK_CHECK_H
+#define STACK_CHECK_H
+
+#include <stdint.h>
+
+//all the RAM between the end of the variables and the top of the stack
+//gets filled with this at startup (before main() runs), whatever is
+//still this byte has never been used by the stack.
+#define STACK_PAINT 0xc5
+
+//returns the most bytes of stack that have been in use at once since
+//startup, counted by looking for the deepest byte that isn't STACK_PAINT
+uint8_t stack_used(void);
+
+//returns how many bytes there are between the variables and the stack
+//in all, so stack_size() - stack_used() is how close it has come
+uint8_t stack_size(void);
+
+#endif
@@ -0,0 +1,92 @@
+//streaming mode
+
+//the decoder, which doesn't care about pins, see stream_avr.c for those
+
+#include "stream.h"
+
+//what the next byte is
+#define ST_HEADER 0
+#define ST_MASK 1
+#define ST_PAYLOAD 2
+#define ST_CHECK 3
+
+void stream_begin(struct stream_state *s){
+    s->state = ST_HEADER;
+    s->need_key = 1;
+}
+
+static uint32_t stream_apply(struct stream_state *s, uint8_t *cols){
+//puts the frame in buf into cols
+    uint32_t changed = 0;
+    uint32_t bit = 1;
+    uint8_t x, i = 0;
+    
+    for(x=0; x<STREAM_COLS; x++, bit<<=1){
+        if(s->mask & bit){
+            uint8_t col = s->buf[i++];
+            if(s->type == STREAM_DELTA){
+                col ^= cols[x];
+            }
+            if(col != cols[x]){
+                cols[x] = col;
+                changed |= bit;
+            }
+        }
+    }
+    return changed;
+}
+
+uint32_t stream_byte(struct stream_state *s, uint8_t *cols, uint8_t b){
+    s->sum += b;
+    
+    switch(s->state){
+        case ST_HEADER:
+            s->type = b;
+            s->sum = b;
+            s->n = 0;
+            if(b == STREAM_KEY){
+                s->mask = 0xffffffff;
+                s->count = STREAM_COLS;
+                s->state = ST_PAYLOAD;
+            } else if(b == STREAM_DELTA){
+                s->mask = 0;
+                s->count = 4;
+                s->state = ST_MASK;
+            }
+            //anything else isn't the start of a frame, skip it
+            break;
+        case ST_MASK:
+            s->mask = (s->mask >> 8) | ((uint32_t)b << 24);
+            if(--s->count == 0){
+                //one byte to come for each column in the mask
+                uint32_t m = s->mask;
+                while(m){
+                    s->count += (m & 1);
+                    m >>= 1;
+                }
+                s->state = s->count ? ST_PAYLOAD : ST_CHECK;
+            }
+            break;
+        case ST_PAYLOAD:
+            s->buf[s->n++] = b;
+            if(--s->count == 0){
+                s->state = ST_CHECK;
+            }
+            break;
+        case ST_CHECK:
+            s->state = ST_HEADER;
+            if(s->sum != 0){
+                //something got lost or mangled, the frames after this one
+                //could be based on it
+                s->need_key = 1;
+                return 0;
+            }
+            if(s->type == STREAM_KEY){
+                s->need_key = 0;
+            } else if(s->need_key){
+                return 0;
+            }
+            return stream_apply(s, cols);
+    }
+    return 0;
+}
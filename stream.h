@@ -0,0 +1,62 @@
+//streaming mode: instead of running its own Game of Life, the board shows
+//frames sent to it by another computer, as fast as they come. they come in
+//on the USI as an SPI slave (see stream_avr.c for the pins), one byte at a
+//time, and are written straight into fb, then display_push() sends only
+//the columns that changed, like after a generation.
+//
+//a frame is one of these, then a check byte that makes all of the frame's
+//bytes (from the header on) add up to 0:
+//
+//  keyframe:  STREAM_KEY, the 32 columns, column 0 first
+//  delta:     STREAM_DELTA, 4 mask bytes (bit x set for column x, the
+//             byte with columns 0-7 first), then for each column set in
+//             the mask, column 0 first, a byte to XOR it with
+//
+//a frame that doesn't check out is thrown away, and deltas are then
+//ignored until the next good keyframe, as they only make sense on top of
+//the frames before them. bytes between frames that aren't a header are
+//skipped, so the decoder finds the next frame by itself.
+//host/stream_enc.c makes these, `make stream_loop` tests the lot.
+
+
+//header file with the streaming stuff
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdint.h>
+
+#define STREAM_KEY 0xa5
+#define STREAM_DELTA 0x5a
+
+#define STREAM_COLS 32
+
+//the part that doesn't care about pins, so the host can run it
+struct stream_state {
+    uint8_t state; //what the next byte is, see stream.c
+    uint8_t type; //STREAM_KEY or STREAM_DELTA
+    uint8_t count; //bytes to go in this part of the frame
+    uint8_t n; //bytes in buf so far
+    uint8_t sum; //of the frame so far
+    uint8_t need_key; //set until a good keyframe has come
+    uint32_t mask; //columns in the frame
+    uint8_t buf[STREAM_COLS]; //held until the check byte says it's good
+};
+
+void stream_begin(struct stream_state *s);
+
+//takes the next byte b. when it finishes a good frame, the frame goes into
+//cols, and this returns the columns that changed (bit x for column x)
+uint32_t stream_byte(struct stream_state *s, uint8_t *cols, uint8_t b);
+
+//the AVR side, in stream_avr.c. the USI interrupt in main.c calls
+//stream_usi_byte() to decode each byte into fb as it comes,
+//stream_take_changed() returns the columns changed since it was last
+//called.
+#ifdef __AVR__
+void init_stream(void);
+void stream_usi_byte(void);
+uint32_t stream_take_changed(void);
+#endif
+
+#endif
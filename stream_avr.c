@@ -0,0 +1,56 @@
+//streaming mode
+
+//the pin side of it, see stream.h
+
+#include "stream.h"
+#include "life.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+//the USI in three wire mode as an SPI slave: DI on PB0 and USCK on PB2,
+//which the 7 segment displays' digits use on the original board, so a
+//streaming board is built without them (see the stream variant). the mcu
+//doesn't send anything back, so DO on PB1 is left alone. data is read on
+//the rising edge of USCK, MSB first (SPI mode 0). a byte has to have been
+//taken by the interrupt before the next one comes, so keep USCK below
+//about 50kHz.
+#define STREAM_DDR DDRB
+#define STREAM_PORT PORTB
+#define STREAM_DI (1<<0)
+#define STREAM_USCK (1<<2)
+
+static struct stream_state stream;
+static volatile uint32_t stream_changed=0; //columns changed since taken
+
+void init_stream(void){
+    STREAM_DDR &= ~(STREAM_DI | STREAM_USCK);
+    STREAM_PORT &= ~(STREAM_DI | STREAM_USCK);
+    stream_begin(&stream);
+    
+    //three wire mode, external clock counted on both edges (so it
+    //overflows after 8 bits), interrupt on overflow
+    USICR = (1<<USIOIE) | (1<<USIWM0) | (1<<USICS1);
+    USISR = (1<<USIOIF); //also zeroes the counter
+}
+
+uint32_t stream_take_changed(void){
+//with interrupts held off, and left how they were after, so it's safe to
+//call with them already off
+    uint32_t changed;
+    uint8_t sreg = SREG;
+    
+    cli();
+    changed = stream_changed;
+    stream_changed = 0;
+    SREG = sreg;
+    return changed;
+}
+
+//called from the USI overflow interrupt in main.c, which is only there in
+//streaming builds, so none of this takes up room in the others
+void stream_usi_byte(void){
+    uint8_t b = USIDR;
+    USISR = (1<<USIOIF);
+    stream_changed |= stream_byte(&stream, fb, b);
+}
@@ -0,0 +1,70 @@
+//readouts other than the generation count for the 7 segment displays
+
+//the functions
+
+#include "telemetry.h"
+
+#include <avr/io.h>
+
+uint8_t tele_mode=TELE_COUNT;
+uint8_t tele_diff=0;
+volatile uint8_t tele_isr_max=0;
+
+static volatile uint8_t tele_ticks=0; //timer1 overflows, wraps every 2.1s
+static volatile uint8_t tele_wrapped=0; //set when tele_ticks wraps
+static uint16_t tele_hour_ticks=0; //wraps of tele_ticks this hour
+static uint8_t tele_resets=0; //this hour
+static uint8_t tele_resets_last=0xff; //the last whole hour, 0xff until
+                                      //there has been one
+
+void init_telemetry(void){
+    //timer0 at CK/8, 1us a count at 8MHz, left free running.
+    //it's only ever read, so it doesn't need its interrupt.
+    TCCR0 |= (1<<CS01);
+}
+
+uint8_t tele_next_mode(void){
+    if(++tele_mode >= TELE_MODES){
+        tele_mode = TELE_COUNT;
+    }
+    if(tele_mode == TELE_ISR_US){
+        //start the timing again, so it's the worst case from now on
+        tele_isr_max = 0;
+    }
+    return tele_mode;
+}
+
+void tele_isr_done(uint8_t start){
+    uint8_t us = TCNT0 - start; //right even if timer0 wrapped once
+    
+    if(us > tele_isr_max){
+        tele_isr_max = us;
+    }
+    if(++tele_ticks == 0){
+        tele_wrapped = 1;
+    }
+}
+
+void tele_reset_seen(void){
+    if(tele_resets < 0xfe){ //0xff is kept for tele_resets_last
+        tele_resets++;
+    }
+}
+
+void tele_service(void){
+    if(tele_wrapped){
+        tele_wrapped = 0;
+        if(++tele_hour_ticks >= TELE_HOUR){
+            tele_hour_ticks = 0;
+            tele_resets_last = tele_resets;
+            tele_resets = 0;
+        }
+    }
+}
+
+uint8_t tele_resets_hour(void){
+    if(tele_resets_last == 0xff){
+        return tele_resets; //not been going for an hour yet
+    }
+    return tele_resets_last;
+}
@@ -0,0 +1,60 @@
+//readouts other than the generation count for the 7 segment displays,
+//for keeping an eye on a board in the field without a debugger
+
+
+//header file with telemetry stuff
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+//what the 7 segment displays show, a long press of the button goes to
+//the next one. each is shown as -n- (its number) for a generation or two
+//first, then updated every generation.
+#define TELE_COUNT 0 //the generation count, same as without telemetry
+#define TELE_POPULATION 1 //live cells, 0-256
+#define TELE_DIFF 2 //the last generation's difference, what
+                    //life_stagnant() goes by
+#define TELE_ISR_US 3 //longest the timer1 ISR has taken, in us, since
+                    //this readout was picked
+#define TELE_RESET_REASON 4 //the RESET_EV_... bits (see main.c) of the
+                    //last grid reset, added up
+#define TELE_RESETS_HOUR 5 //grid resets in the last hour, or so far
+                    //in the first one
+#define TELE_STACK 6 //most bytes of stack used, see stack_check.h
+//with DO_YOU_WANT_SCHEDULER (set from the Makefile, so it's seen here)
+#if defined(DO_YOU_WANT_SCHEDULER) && DO_YOU_WANT_SCHEDULER
+#define TELE_TASK_US 7 //longest any one main loop task has taken, in
+                    //32us (SCHED_TIME_US) steps, see sched.h
+#define TELE_MODES 8
+#else
+#define TELE_MODES 7
+#endif
+
+//timer1 overflows (8.192ms) in an hour, counted 256 at a time
+#define TELE_HOUR 1717 //1717*256*8.192ms = 3600.7s
+
+extern uint8_t tele_mode; //one of the above
+extern uint8_t tele_diff; //set by main.c every generation
+extern volatile uint8_t tele_isr_max;
+
+//starts timer0 counting in us (CK/8 at 8MHz), for timing the ISR
+void init_telemetry(void);
+
+//goes to the next readout and returns it
+uint8_t tele_next_mode(void);
+
+//call at the end of the timer1 ISR with TCNT0 from the start of it.
+//the pushes and pops around the ISR aren't counted, that's a few us more.
+void tele_isr_done(uint8_t start);
+
+//call when the grid gets reset
+void tele_reset_seen(void);
+
+//keeps the hour for TELE_RESETS_HOUR, call from the main loop
+void tele_service(void);
+
+uint8_t tele_resets_hour(void);
+
+#endif